@@ -0,0 +1,142 @@
+#include "BenchmarkUtils.hpp"
+
+#include "AdditionalInfoData.hpp"
+#include "AdditionalSettings.hpp"
+#include "CombatWidget.hpp"
+#include "RuleSettings.hpp"
+#include "TableFileHandler.hpp"
+
+#include <QFile>
+#include <QJsonDocument>
+
+#include <random>
+
+namespace BenchmarkUtils
+{
+namespace
+{
+qint64
+readProcStatusValue(const QByteArray& key)
+{
+    QFile statusFile("/proc/self/status");
+    if (!statusFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+    // Lines are formatted like "VmHWM:     1234 kB"
+    while (!statusFile.atEnd()) {
+        const auto line = statusFile.readLine();
+        if (line.startsWith(key + ':')) {
+            return line.mid(key.size() + 1).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return -1;
+}
+}
+
+
+QVector<CharacterHandler::Character>
+generateCharacters(int count)
+{
+    static const QStringList names{ "Goblin", "Fighter", "Wizard", "Orc", "Cleric", "Wolf", "Rogue", "Dragon" };
+    static const QStringList effects{ "Shaken", "Blinded", "Haste", "Prone", "Exhausted" };
+
+    // Fixed seed, so all runs use the same roster
+    std::mt19937 gen(count);
+    std::uniform_int_distribution<> iniDistr(1, 30);
+    std::uniform_int_distribution<> modifierDistr(-2, 8);
+    std::uniform_int_distribution<> hpDistr(1, 250);
+    std::uniform_int_distribution<> effectDistr(0, effects.size() * 2);
+
+    QVector<CharacterHandler::Character> characters;
+    characters.reserve(count);
+    for (auto i = 0; i < count; i++) {
+        AdditionalInfoData additionalInfoData{ {}, i % 3 == 0 ? "Haste" : "" };
+        // About half of the characters have a status effect
+        if (const auto effect = effectDistr(gen); effect < effects.size()) {
+            additionalInfoData.statusEffects.push_back(AdditionalInfoData::StatusEffect(effects.at(effect), effect % 2 == 0,
+                                                                                        effect + 1));
+        }
+        // Many equal ini values, so the tie breakers are used as well
+        characters.push_back(CharacterHandler::Character(names.at(i % names.size()) + " " + QString::number(i), iniDistr(gen),
+                                                         modifierDistr(gen), hpDistr(gen), i % 2 == 0, additionalInfoData));
+    }
+    return characters;
+}
+
+
+std::unique_ptr<CombatWidget>
+createCombatWidget(std::shared_ptr<TableFileHandler> tableFileHandler, int count)
+{
+    // The settings have to outlive the widget as well
+    static const AdditionalSettings additionalSettings;
+    static const RuleSettings ruleSettings;
+
+    // Load the roster the same way a stored table is opened
+    const auto fileName = QString("./benchmark_roster_%1.lcm").arg(count);
+    static_cast<void>(tableFileHandler->writeToFile(generateCharacters(count), fileName, 0, 1,
+                                                    ruleSettings.ruleset, ruleSettings.rollAutomatical));
+    static_cast<void>(tableFileHandler->getStatus(fileName));
+    QFile::remove(fileName);
+
+    auto combatWidget = std::make_unique<CombatWidget>(tableFileHandler, additionalSettings, ruleSettings, 720, true);
+    combatWidget->generateTableFromTableData();
+    return combatWidget;
+}
+
+
+void
+writeSyntheticTable(const QString& fileName, qint64 minimumSize)
+{
+    const CharacterHandler::Character character("Fighter", 19, 2, 36, false,
+                                                AdditionalInfoData{ { { "Shaken", false, 2 }, { "Exhausted", true, 0 } }, "Haste" });
+
+    // Build the text directly, inserting several hundred thousand characters into a QJsonObject is too slow
+    auto characterArray = QJsonDocument(TableFileHandler::createCharacterObject(character)).toJson();
+    characterArray.chop(1);
+    characterArray.replace('\n', "\n    ");
+
+    QFile fileOut(fileName);
+    fileOut.open(QIODevice::WriteOnly);
+    fileOut.write("{\n    \"row_entered\": 0,\n    \"round_counter\": 1,\n    \"ruleset\": 0,\n"
+                  "    \"roll_automatically\": false,\n    \"characters\": {\n");
+
+    QByteArray charactersArray;
+    auto characterCount = 0;
+    while (fileOut.size() + charactersArray.size() < minimumSize) {
+        charactersArray.append((characterCount == 0 ? "        \"" : ",\n        \"") + QByteArray::number(characterCount) + "\": ");
+        charactersArray.append(characterArray);
+        characterCount++;
+        // Keep the buffer small
+        if (charactersArray.size() > 1024 * 1024) {
+            fileOut.write(charactersArray);
+            charactersArray.clear();
+        }
+    }
+    fileOut.write(charactersArray);
+    fileOut.write("\n    }\n}\n");
+}
+
+
+void
+resetPeakMemory()
+{
+    QFile clearRefsFile("/proc/self/clear_refs");
+    if (clearRefsFile.open(QIODevice::WriteOnly)) {
+        clearRefsFile.write("5");
+    }
+}
+
+
+qint64
+getPeakMemory()
+{
+    return readProcStatusValue("VmHWM");
+}
+
+
+qint64
+getCurrentMemory()
+{
+    return readProcStatusValue("VmRSS");
+}
+}
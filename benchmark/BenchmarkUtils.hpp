@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CharacterHandler.hpp"
+
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+class CombatWidget;
+class TableFileHandler;
+
+// Helper functions shared by the benchmarks
+namespace BenchmarkUtils
+{
+// Create a roster of different characters. The same count always delivers the same roster.
+// This is also the table data format used by the file handler and the undo stack
+[[nodiscard]] QVector<CharacterHandler::Character>
+generateCharacters(int count);
+
+// Create a combat widget containing the generated roster. The table file handler has to outlive the widget
+[[nodiscard]] std::unique_ptr<CombatWidget>
+createCombatWidget(std::shared_ptr<TableFileHandler> tableFileHandler,
+                   int                               count);
+
+// Write an lcm table in the current format, adding characters until the given size is reached
+void
+writeSyntheticTable(const QString& fileName,
+                    qint64         minimumSize);
+
+// Reset the peak resident memory of this process to the current one. Linux only
+void
+resetPeakMemory();
+
+// Current peak resident memory in KB, -1 if it is not available
+[[nodiscard]] qint64
+getPeakMemory();
+
+// Current resident memory in KB, -1 if it is not available
+[[nodiscard]] qint64
+getCurrentMemory();
+}
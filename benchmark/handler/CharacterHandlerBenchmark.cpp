@@ -0,0 +1,64 @@
+#include "BenchmarkUtils.hpp"
+#include "CharacterHandler.hpp"
+#include "UtilsGeneral.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <string>
+#include <vector>
+
+// Sorting of unsorted rosters for every ruleset, with and without automatic tie breaking
+TEST_CASE("Character sorting benchmark", "[CharacterHandlerBenchmark]") {
+    for (const auto count : { 10, 100, 1000, 10000, 100000 }) {
+        const auto characters = BenchmarkUtils::generateCharacters(count);
+
+        for (const auto ruleset : { RuleSettings::Ruleset::PATHFINDER_1E_DND_35E, RuleSettings::Ruleset::PATHFINDER_2E,
+                                    RuleSettings::Ruleset::DND_5E, RuleSettings::Ruleset::DND_30E,
+                                    RuleSettings::Ruleset::STARFINDER }) {
+            for (const auto rollAutomatically : { false, true }) {
+                const auto name = "Sort, " + Utils::General::getRulesetName(ruleset).toStdString() +
+                                  (rollAutomatically ? ", automatic" : "") + ", " + std::to_string(count) + " characters";
+
+                BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+                    // Every run needs its own unsorted roster
+                    std::vector<CharacterHandler> characterHandlers(meter.runs());
+                    for (auto& characterHandler : characterHandlers) {
+                        characterHandler.getCharacters() = characters;
+                    }
+                    meter.measure([&characterHandlers, ruleset, rollAutomatically] (int i) {
+                        characterHandlers[i].sortCharacters(ruleset, rollAutomatically);
+                    });
+                };
+            }
+        }
+    }
+}
+
+
+// Area damage for every second character, with a different rule per target
+TEST_CASE("Bulk hp change benchmark", "[CharacterHandlerBenchmark]") {
+    for (const auto count : { 10, 100, 1000, 10000, 100000 }) {
+        const auto characters = BenchmarkUtils::generateCharacters(count);
+
+        QVector<CharacterHandler::HpChange> hpChanges;
+        for (auto i = 0; i < count; i += 2) {
+            hpChanges.push_back({ i, -14, static_cast<CharacterHandler::HpRule>(i % 4 == 0 ? 0 : 1) });
+        }
+
+        BENCHMARK_ADVANCED("Change hp, " + std::to_string(count / 2) + " of " + std::to_string(count) + " characters")(
+            Catch::Benchmark::Chronometer meter) {
+            std::vector<CharacterHandler> characterHandlers(meter.runs());
+            for (auto& characterHandler : characterHandlers) {
+                characterHandler.getCharacters() = characters;
+            }
+            meter.measure([&characterHandlers, &hpChanges] (int i) {
+                return characterHandlers[i].applyHpChanges(hpChanges).size();
+            });
+        };
+    }
+}
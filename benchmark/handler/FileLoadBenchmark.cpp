@@ -0,0 +1,46 @@
+#include "BenchmarkUtils.hpp"
+#include "TableFileHandler.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QFile>
+
+#include <iostream>
+#include <string>
+
+// Compares the buffered and the memory mapped file loading for synthetic tables
+TEST_CASE("Table loading benchmark", "[FileLoadBenchmark]") {
+    TableFileHandler tableFileHandler;
+
+    for (const auto sizeInMB : { 1, 10, 100 }) {
+        const auto fileName = QString("./benchmark_%1mb.lcm").arg(sizeInMB);
+        BenchmarkUtils::writeSyntheticTable(fileName, (qint64) sizeInMB * 1024 * 1024);
+
+        for (const auto useMemoryMapping : { false, true }) {
+            const auto readMode = std::string(useMemoryMapping ? "mapped" : "buffered");
+            tableFileHandler.setMemoryMappingEnabled(useMemoryMapping);
+
+            // Peak memory of a single load, the data of a previous load is released first
+            tableFileHandler.getData() = QJsonObject();
+            const auto memoryBefore = BenchmarkUtils::getCurrentMemory();
+            BenchmarkUtils::resetPeakMemory();
+            REQUIRE(tableFileHandler.getStatus(fileName) == 0);
+            const auto peakMemory = BenchmarkUtils::getPeakMemory();
+            if (memoryBefore != -1 && peakMemory != -1) {
+                std::cout << "Peak memory increase, " << readMode << ", " << sizeInMB << " MB: "
+                          << (peakMemory - memoryBefore) / 1024 << " MB" << std::endl;
+            }
+
+            BENCHMARK("Load time, " + readMode + ", " + std::to_string(sizeInMB) + " MB") {
+                return tableFileHandler.getStatus(fileName);
+            };
+        }
+
+        QFile::remove(fileName);
+    }
+}
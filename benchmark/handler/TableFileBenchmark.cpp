@@ -0,0 +1,34 @@
+#include "BenchmarkUtils.hpp"
+#include "TableFileHandler.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QFile>
+
+#include <string>
+
+// Saving and loading of generated rosters
+TEST_CASE("Table saving and loading benchmark", "[TableFileBenchmark]") {
+    TableFileHandler tableFileHandler;
+
+    for (const auto count : { 10, 100, 1000, 10000, 100000 }) {
+        const auto tableData = BenchmarkUtils::generateCharacters(count);
+        const auto fileName = QString("./benchmark_table_%1.lcm").arg(count);
+
+        BENCHMARK("Write, " + std::to_string(count) + " characters") {
+            return tableFileHandler.writeToFile(tableData, fileName, 0, 1, RuleSettings::Ruleset::PATHFINDER_2E, true);
+        };
+
+        REQUIRE(tableFileHandler.getStatus(fileName) == 0);
+        BENCHMARK("Load, " + std::to_string(count) + " characters") {
+            return tableFileHandler.getStatus(fileName);
+        };
+
+        QFile::remove(fileName);
+    }
+}
@@ -0,0 +1,32 @@
+#define CATCH_CONFIG_RUNNER
+
+#ifdef CATCH2_V3
+#include <catch2/catch_session.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QApplication>
+
+int
+main(int argc, char **argv)
+{
+#ifdef _WIN32
+    _putenv("QT_QPA_PLATFORM=offscreen");
+#else
+    setenv("QT_QPA_PLATFORM", "offscreen", 0);
+#endif
+
+    QApplication app(argc, argv);
+    app.setApplicationName("LCM");
+    app.setOrganizationName("LCM");
+
+    Catch::Session session;
+    // Loading the large tables takes a while, so use fewer samples unless requested otherwise
+    session.configData().benchmarkSamples = 10;
+    if (const auto result = session.applyCommandLine(argc, argv); result != 0) {
+        return result;
+    }
+
+    return session.run();
+}
@@ -0,0 +1,96 @@
+#include "BenchmarkUtils.hpp"
+#include "CombatWidget.hpp"
+#include "TableFileHandler.hpp"
+#include "UtilsTable.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QUndoStack>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+void
+runCombatTableBenchmarks(int count)
+{
+    auto tableFileHandler = std::make_shared<TableFileHandler>();
+    const auto combatWidget = BenchmarkUtils::createCombatWidget(tableFileHandler, count);
+    auto *const tableWidget = combatWidget->getCombatTableWidget();
+    auto *const undoStack = combatWidget->findChild<QUndoStack *>();
+    REQUIRE(tableWidget->rowCount() == count);
+
+    const auto rows = ", " + std::to_string(count) + " rows";
+
+    BENCHMARK("Resynchronize characters" + rows) {
+        tableWidget->resynchronizeCharacters();
+    };
+    BENCHMARK("Table data from widget" + rows) {
+        return tableWidget->tableDataFromWidget();
+    };
+    BENCHMARK("Table data from character vector" + rows) {
+        return tableWidget->tableDataFromCharacterVector();
+    };
+
+    // A single edited hp value, the same way a change in the table is stored
+    auto hp = 0;
+    const auto changeHP = [&combatWidget, tableWidget, &hp] {
+        combatWidget->saveOldState();
+        tableWidget->blockSignals(true);
+        tableWidget->item(0, Utils::Table::COL_HP)->setText(QString::number(++hp));
+        tableWidget->blockSignals(false);
+        combatWidget->pushOnUndoStack(true);
+    };
+
+    BENCHMARK("Undo push" + rows) {
+        changeHP();
+    };
+    BENCHMARK_ADVANCED("Undo" + rows)(Catch::Benchmark::Chronometer meter) {
+        for (auto i = 0; i < meter.runs(); i++) {
+            changeHP();
+        }
+        meter.measure([undoStack] {
+            undoStack->undo();
+        });
+    };
+    BENCHMARK_ADVANCED("Redo" + rows)(Catch::Benchmark::Chronometer meter) {
+        for (auto i = 0; i < meter.runs(); i++) {
+            changeHP();
+        }
+        for (auto i = 0; i < meter.runs(); i++) {
+            undoStack->undo();
+        }
+        meter.measure([undoStack] {
+            undoStack->redo();
+        });
+    };
+
+    // Scattered rows, the worst case for removing contiguous runs
+    std::vector<int> removedRows;
+    for (auto i = 0; i < count; i += 5) {
+        removedRows.push_back(i);
+    }
+    BENCHMARK("Remove every fifth row and undo" + rows) {
+        combatWidget->removeRows(removedRows);
+        undoStack->undo();
+    };
+}
+}
+
+TEST_CASE("Combat table benchmark", "[CombatTableBenchmark]") {
+    for (const auto count : { 10, 100, 1000, 10000 }) {
+        runCombatTableBenchmarks(count);
+    }
+}
+
+
+// Creating the cell widgets for this many rows takes a while, so this case has to be selected explicitly
+TEST_CASE("Combat table benchmark, large table", "[CombatTableBenchmark][.large]") {
+    runCombatTableBenchmarks(100000);
+}
@@ -2,6 +2,112 @@
 
 #include <QCryptographicHash>
 
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+// FNV-1a, which is fast for the few bytes of a row
+constexpr quint64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr quint64 FNV_PRIME = 1099511628211ULL;
+
+void
+addBytes(quint64& fingerprint, const void* data, std::size_t size)
+{
+    const auto* const bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; i++) {
+        fingerprint = (fingerprint ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+
+template<typename T>
+void
+addValue(quint64& fingerprint, T value)
+{
+    addBytes(fingerprint, &value, sizeof(T));
+}
+
+
+void
+addString(quint64& fingerprint, const QString& string)
+{
+    // Add the length as well, so neighboring strings can not be shifted into each other
+    addValue(fingerprint, string.size());
+    addBytes(fingerprint, string.constData(), string.size() * sizeof(QChar));
+}
+}
+
+
+quint64
+CharacterHandler::Character::getFingerprint() const
+{
+    auto fingerprint = FNV_OFFSET_BASIS;
+    addString(fingerprint, name);
+    addValue(fingerprint, initiative);
+    addValue(fingerprint, modifier);
+    addValue(fingerprint, hp);
+    addValue(fingerprint, isEnemy);
+
+    addValue(fingerprint, instanceHp.size());
+    for (const auto value : instanceHp) {
+        addValue(fingerprint, value);
+    }
+
+    addString(fingerprint, additionalInfoData.mainInfoText);
+    addValue(fingerprint, additionalInfoData.statusEffects.size());
+    for (const auto& statusEffect : additionalInfoData.statusEffects) {
+        addString(fingerprint, statusEffect.name);
+        addValue(fingerprint, statusEffect.isPermanent);
+        addValue(fingerprint, statusEffect.duration);
+    }
+    return fingerprint;
+}
+
+
+void
+CharacterHandler::Character::setInstanceHp(const QVector<int>& hpValues)
+{
+    instanceHp = hpValues;
+    hp = std::accumulate(instanceHp.begin(), instanceHp.end(), 0);
+}
+
+
+void
+CharacterHandler::Character::changeHp(int value, int instance)
+{
+    if (!isGroup()) {
+        hp = std::clamp(hp + value, MIN_HP, MAX_HP);
+        return;
+    }
+
+    auto changedInstanceHp = instanceHp;
+    for (auto i = 0; i < changedInstanceHp.size(); i++) {
+        if (instance < 0 || i == instance) {
+            changedInstanceHp[i] = std::clamp(changedInstanceHp.at(i) + value, MIN_HP, MAX_HP);
+        }
+    }
+    setInstanceHp(changedInstanceHp);
+}
+
+
+QVector<CharacterHandler::Character>
+CharacterHandler::Character::getInstances(bool addIndicator) const
+{
+    if (!isGroup()) {
+        return { *this };
+    }
+
+    QVector<Character> instances;
+    instances.reserve(instanceHp.size());
+    for (auto i = 0; i < instanceHp.size(); i++) {
+        instances.push_back(Character(addIndicator ? name + " #" + QString::number(i + 1) : name,
+                                      initiative, modifier, instanceHp.at(i), isEnemy, additionalInfoData));
+    }
+    return instances;
+}
+
+
 // Stores a new character
 void
 CharacterHandler::storeCharacter(
@@ -17,7 +123,7 @@ CharacterHandler::storeCharacter(
 
 
 // Sort all created characters, depending on the used rulset
-void
+QVector<int>
 CharacterHandler::sortCharacters(const RuleSettings::Ruleset& ruleset, bool rollAutomatically)
 {
     const auto sortUsingHashes = [&] (const auto& c1, const auto& c2) {
@@ -31,8 +137,13 @@ CharacterHandler::sortCharacters(const RuleSettings::Ruleset& ruleset, bool roll
                false;
     };
 
-    std::sort(characters.begin(), characters.end(),
-              [ruleset, sortUsingHashes](const auto& c1, const auto& c2) {
+    // Sort the indices, so the old position of every character is known afterwards
+    QVector<int> sourceRows(characters.size());
+    std::iota(sourceRows.begin(), sourceRows.end(), 0);
+    std::sort(sourceRows.begin(), sourceRows.end(),
+              [this, ruleset, sortUsingHashes](int first, int second) {
+        const auto& c1 = characters.at(first);
+        const auto& c2 = characters.at(second);
         // Common for all rulesets: Sort for higher initiative
         if (c1.initiative != c2.initiative) {
             return c1.initiative > c2.initiative;
@@ -63,6 +174,14 @@ CharacterHandler::sortCharacters(const RuleSettings::Ruleset& ruleset, bool roll
             return false;
         }
     });
+
+    QVector<Character> sortedCharacters;
+    sortedCharacters.reserve(characters.size());
+    for (const auto sourceRow : sourceRows) {
+        sortedCharacters.push_back(characters.at(sourceRow));
+    }
+    characters = sortedCharacters;
+    return sourceRows;
 }
 
 
@@ -73,3 +192,51 @@ CharacterHandler::clearCharacters()
         characters.clear();
     }
 }
+
+
+std::vector<int>
+CharacterHandler::applyHpChanges(const QVector<HpChange>& hpChanges)
+{
+    std::vector<int> changedRows;
+    changedRows.reserve(hpChanges.size());
+
+    for (const auto& hpChange : hpChanges) {
+        if (hpChange.row < 0 || hpChange.row >= characters.size()) {
+            continue;
+        }
+        const auto value = getRuledHpValue(hpChange.value, hpChange.rule);
+        if (value == 0) {
+            continue;
+        }
+
+        auto& character = characters[hpChange.row];
+        const auto oldHp = character.hp;
+        const auto oldInstanceHp = character.instanceHp;
+        character.changeHp(value, hpChange.instance);
+        if (character.hp != oldHp || character.instanceHp != oldInstanceHp) {
+            changedRows.push_back(hpChange.row);
+        }
+    }
+
+    // A row might be changed multiple times
+    std::sort(changedRows.begin(), changedRows.end());
+    changedRows.erase(std::unique(changedRows.begin(), changedRows.end()), changedRows.end());
+    return changedRows;
+}
+
+
+int
+CharacterHandler::getRuledHpValue(int value, HpRule rule)
+{
+    switch (rule) {
+    case HpRule::HALF:
+        // Integer division rounds toward zero, so halved damage and healing have the same magnitude
+        return value / 2;
+    case HpRule::DOUBLE:
+        return value * 2;
+    case HpRule::NONE:
+        return 0;
+    default:
+        return value;
+    }
+}
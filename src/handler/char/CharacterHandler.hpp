@@ -3,6 +3,8 @@
 #include "AdditionalInfoData.hpp"
 #include "RuleSettings.hpp"
 
+#include <vector>
+
 // This class handles the creation, sorting and deletion of the created characters
 class CharacterHandler {
 public:
@@ -22,6 +24,8 @@ public:
         bool               isEnemy;
         // Various information, including status effects
         AdditionalInfoData additionalInfoData;
+        // Hp of every instance if this is a group of identical characters, empty for a single character
+        QVector<int>       instanceHp{};
 
         Character(const QString& name, int initiative, int modifier, int hp, bool isEnemy,
                   const AdditionalInfoData& additionalInfoData) :
@@ -30,6 +34,71 @@ public:
             additionalInfoData(std::move(additionalInfoData))
         {
         }
+
+        // Cheap fields first, so most different rows are detected without comparing strings
+        [[nodiscard]] bool
+        operator==(const Character& other) const
+        {
+            return hp == other.hp && initiative == other.initiative && modifier == other.modifier &&
+                   isEnemy == other.isEnemy && instanceHp == other.instanceHp && name == other.name &&
+                   additionalInfoData == other.additionalInfoData;
+        }
+
+        [[nodiscard]] bool
+        operator!=(const Character& other) const
+        {
+            return !(*this == other);
+        }
+
+        // 64 bit fingerprint of all values, equal characters always have the same fingerprint
+        [[nodiscard]] quint64
+        getFingerprint() const;
+
+        [[nodiscard]] bool
+        isGroup() const
+        {
+            return !instanceHp.empty();
+        }
+
+        [[nodiscard]] int
+        getInstanceCount() const
+        {
+            return isGroup() ? instanceHp.size() : 1;
+        }
+
+        // Turn the character into a group, the hp is the sum of all instances
+        void
+        setInstanceHp(const QVector<int>& hpValues);
+
+        // Change the hp. For a group, only the given instance is changed, or all of them if it is negative
+        void
+        changeHp(int value,
+                 int instance = -1);
+
+        // Single characters for all instances of a group, sharing everything except the hp
+        [[nodiscard]] QVector<Character>
+        getInstances(bool addIndicator) const;
+
+        static constexpr int MIN_HP = -10000;
+        static constexpr int MAX_HP = 10000;
+    };
+
+    // How a hp change affects a single character, for example if a saving throw succeeded
+    enum class HpRule {
+        FULL,
+        HALF,
+        DOUBLE,
+        NONE
+    };
+
+    struct HpChange {
+        // Index of the changed character
+        int    row;
+        // Negative for damage, positive for healing
+        int    value;
+        HpRule rule{ HpRule::FULL };
+        // Changed instance of a group, all instances if negative
+        int    instance{ -1 };
     };
 
 public:
@@ -41,13 +110,23 @@ public:
                    bool               isEnemy,
                    AdditionalInfoData additionalInfoData);
 
-    void
+    // Returns the old index of every sorted character
+    QVector<int>
     sortCharacters(const RuleSettings::Ruleset& ruleset,
                    bool                         rollAutomatically);
 
     void
     clearCharacters();
 
+    // Apply different hp changes to multiple characters in a single pass, returns the changed rows
+    std::vector<int>
+    applyHpChanges(const QVector<HpChange>& hpChanges);
+
+    // Halved values are rounded toward zero
+    [[nodiscard]] static int
+    getRuledHpValue(int    value,
+                    HpRule rule);
+
     [[nodiscard]] QVector<Character>&
     getCharacters()
     {
@@ -60,3 +139,16 @@ private:
 };
 
 Q_DECLARE_METATYPE(CharacterHandler::Character);
+
+
+[[nodiscard]] inline HashValue
+qHash(const CharacterHandler::Character& character, HashValue seed = 0)
+{
+    seed = combineHash(seed, qHash(character.name));
+    seed = combineHash(seed, qHash(character.initiative));
+    seed = combineHash(seed, qHash(character.modifier));
+    seed = combineHash(seed, qHash(character.hp));
+    seed = combineHash(seed, qHash(character.isEnemy));
+    seed = combineHash(seed, qHash(character.instanceHp));
+    return combineHash(seed, qHash(character.additionalInfoData));
+}
@@ -1,11 +1,15 @@
 #include "BaseFileHandler.hpp"
 
+#include "UtilsTrace.hpp"
+
 #include <QFile>
 #include <QJsonDocument>
 
 int
 BaseFileHandler::getStatus(const QString& fileName)
 {
+    TRACE_SCOPE("BaseFileHandler::getStatus");
+
     // Try to open
     QFile fileIn(fileName);
     if (!fileIn.open(QIODevice::ReadOnly)) {
@@ -13,9 +17,27 @@ BaseFileHandler::getStatus(const QString& fileName)
         return 2;
     }
 
-    auto byteArray = fileIn.readAll();
-    const auto document = QJsonDocument::fromJson(byteArray);
+    const auto document = parseFile(fileIn, m_memoryMappingEnabled);
     m_fileData = document.object();
     // Correct or false format
     return !checkFileFormat();
 }
+
+
+QJsonDocument
+BaseFileHandler::parseFile(QFile& file, bool useMemoryMapping)
+{
+    const auto fileSize = file.size();
+    if (useMemoryMapping && fileSize > 0) {
+        if (auto *const mappedData = file.map(0, fileSize); mappedData) {
+            // The parser copies everything it needs, so the raw data only has to live until parsing is done
+            const auto byteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData), fileSize);
+            const auto document = QJsonDocument::fromJson(byteArray);
+            file.unmap(mappedData);
+            return document;
+        }
+    }
+
+    // Mapping is not possible for every file, for example for sequential devices
+    return QJsonDocument::fromJson(file.readAll());
+}
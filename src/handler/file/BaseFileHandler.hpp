@@ -2,6 +2,9 @@
 
 #include <QJsonObject>
 
+class QFile;
+class QJsonDocument;
+
 class BaseFileHandler {
 public:
     [[nodiscard]] virtual int
@@ -13,10 +16,26 @@ public:
         return m_fileData;
     }
 
+    // Mapping is used by default, disabling it reads the whole file into a buffer first
+    void
+    setMemoryMappingEnabled(bool enabled)
+    {
+        m_memoryMappingEnabled = enabled;
+    }
+
+    // Parse an opened file. If possible, the file is mapped into memory
+    // and parsed in place instead of being copied into a buffer
+    [[nodiscard]] static QJsonDocument
+    parseFile(QFile& file,
+              bool   useMemoryMapping = true);
+
 protected:
     QJsonObject m_fileData;
 
 private:
     [[nodiscard]] virtual bool
     checkFileFormat() const = 0;
+
+private:
+    bool m_memoryMappingEnabled{ true };
 };
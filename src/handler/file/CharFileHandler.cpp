@@ -18,16 +18,8 @@ CharFileHandler::CharFileHandler()
 bool
 CharFileHandler::writeToFile(const CharacterHandler::Character &character) const
 {
-    QJsonObject characterObject;
-    characterObject["name"] = character.name;
-    characterObject["initiative"] = character.initiative;
-    characterObject["modifier"] = character.modifier;
-    characterObject["hp"] = character.hp;
-    characterObject["is_enemy"] = character.isEnemy;
-    characterObject["additional_info"] = character.additionalInfoData.mainInfoText;
-
     // Write to file
-    const auto byteArray = QJsonDocument(characterObject).toJson();
+    const auto byteArray = QJsonDocument(createCharacterObject(character)).toJson();
     QFile fileOut(m_directoryString + "/" + character.name + ".char");
     fileOut.open(QIODevice::WriteOnly);
     return fileOut.write(byteArray);
@@ -52,12 +44,55 @@ CharFileHandler::getStatus(const QString& fileName)
 }
 
 
+QJsonObject
+CharFileHandler::createCharacterObject(const CharacterHandler::Character& character)
+{
+    QJsonObject characterObject;
+    characterObject["name"] = character.name;
+    characterObject["initiative"] = character.initiative;
+    characterObject["modifier"] = character.modifier;
+    characterObject["hp"] = character.hp;
+    characterObject["is_enemy"] = character.isEnemy;
+    characterObject["additional_info"] = character.additionalInfoData.mainInfoText;
+
+    return characterObject;
+}
+
+
+int
+CharFileHandler::readCharacter(const QString& filePath, CharacterHandler::Character& character)
+{
+    QFile fileIn(filePath);
+    if (!fileIn.open(QIODevice::ReadOnly)) {
+        return 2;
+    }
+
+    const auto characterObject = parseFile(fileIn).object();
+    if (!isCharacterObject(characterObject)) {
+        return 1;
+    }
+
+    character = CharacterHandler::Character(characterObject["name"].toString(), characterObject["initiative"].toInt(),
+                                            characterObject["modifier"].toInt(), characterObject["hp"].toInt(),
+                                            characterObject["is_enemy"].toBool(),
+                                            AdditionalInfoData{ {}, characterObject["additional_info"].toString() });
+    return 0;
+}
+
+
 bool
 CharFileHandler::checkFileFormat() const
 {
-    auto checker = !m_fileData.empty() && m_fileData.contains("name") && m_fileData.contains("initiative") &&
-                   m_fileData.contains("modifier") && m_fileData.contains("hp") &&
-                   m_fileData.contains("is_enemy") && m_fileData.contains("additional_info");
+    return isCharacterObject(m_fileData);
+}
+
+
+bool
+CharFileHandler::isCharacterObject(const QJsonObject& characterObject)
+{
+    auto checker = !characterObject.empty() && characterObject.contains("name") && characterObject.contains("initiative") &&
+                   characterObject.contains("modifier") && characterObject.contains("hp") &&
+                   characterObject.contains("is_enemy") && characterObject.contains("additional_info");
 
     return checker;
 }
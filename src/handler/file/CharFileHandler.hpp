@@ -20,6 +20,16 @@ public:
     [[nodiscard]] int
     getStatus(const QString& fileName) override;
 
+    // Convert a character into the json object stored in a template file
+    [[nodiscard]] static QJsonObject
+    createCharacterObject(const CharacterHandler::Character& character);
+
+    // Read a template file without using the handler's data, so it is safe to call from a
+    // worker thread. Returns the same codes as getStatus
+    [[nodiscard]] static int
+    readCharacter(const QString&               filePath,
+                  CharacterHandler::Character& character);
+
     const QString&
     getDirectoryString()
     {
@@ -31,6 +41,9 @@ private:
     [[nodiscard]] bool
     checkFileFormat() const override;
 
+    [[nodiscard]] static bool
+    isCharacterObject(const QJsonObject& characterObject);
+
 private:
     QString m_directoryString;
 };
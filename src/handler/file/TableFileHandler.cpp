@@ -1,18 +1,82 @@
 #include "TableFileHandler.hpp"
 
 #include "AdditionalInfoData.hpp"
+#include "UtilsTrace.hpp"
 
 #include <QFile>
+#include <QJsonArray>
 #include <QJsonDocument>
+#include <QSaveFile>
 
 bool
 TableFileHandler::writeToFile(
-    const QVector<QVector<QVariant> >& tableData,
-    const QString&                     fileName,
-    unsigned int                       rowEntered,
-    unsigned int                       roundCounter,
-    const RuleSettings::Ruleset&       ruleset,
-    bool                               rollAutomatically) const
+    const QVector<CharacterHandler::Character>& tableData,
+    const QString&                              fileName,
+    unsigned int                                rowEntered,
+    unsigned int                                roundCounter,
+    const RuleSettings::Ruleset&                ruleset,
+    bool                                        rollAutomatically) const
+{
+    TRACE_SCOPE("TableFileHandler::writeToFile");
+
+    QJsonObject charactersObject;
+    for (auto i = 0; i < tableData.size(); i++) {
+        charactersObject[QString::number(i)] = createCharacterObject(tableData.at(i));
+    }
+
+    const auto lcmFile = createTableObject(charactersObject, rowEntered, roundCounter, ruleset, rollAutomatically);
+    return writeTableObject(lcmFile, fileName);
+}
+
+
+QJsonObject
+TableFileHandler::createCharacterObject(const CharacterHandler::Character& character)
+{
+    // Character values
+    QJsonObject singleCharacterObject;
+    singleCharacterObject["name"] = character.name;
+    singleCharacterObject["initiative"] = character.initiative;
+    singleCharacterObject["modifier"] = character.modifier;
+    singleCharacterObject["hp"] = character.hp;
+    singleCharacterObject["is_enemy"] = character.isEnemy;
+    // Only stored for groups, so tables without groups keep their format
+    if (character.isGroup()) {
+        QJsonArray instanceHpArray;
+        for (const auto value : character.instanceHp) {
+            instanceHpArray.append(value);
+        }
+        singleCharacterObject["instance_hp"] = instanceHpArray;
+    }
+
+    // Additional info
+    QJsonObject additionalInfoObject;
+    const auto& addInfo = character.additionalInfoData;
+    additionalInfoObject["main_info"] = addInfo.mainInfoText;
+
+    // Status effects for additional info
+    QJsonObject statusEffectsObject;
+    for (auto j = 0; j < addInfo.statusEffects.size(); j++) {
+        const auto& statusEffect = addInfo.statusEffects.at(j);
+        QJsonObject singleEffectObject;
+        singleEffectObject["name"] = statusEffect.name;
+        singleEffectObject["duration"] = (int) statusEffect.duration;
+        singleEffectObject["is_permanent"] = statusEffect.isPermanent;
+
+        statusEffectsObject[QString::number(j)] = singleEffectObject;
+    }
+    additionalInfoObject["status_effects"] = statusEffectsObject;
+    singleCharacterObject["additional_info"] = additionalInfoObject;
+
+    return singleCharacterObject;
+}
+
+
+QJsonObject
+TableFileHandler::createTableObject(const QJsonObject&           charactersObject,
+                                    unsigned int                 rowEntered,
+                                    unsigned int                 roundCounter,
+                                    const RuleSettings::Ruleset& ruleset,
+                                    bool                         rollAutomatically)
 {
     // Main combat stats
     QJsonObject lcmFile;
@@ -20,46 +84,95 @@ TableFileHandler::writeToFile(
     lcmFile["round_counter"] = (int) roundCounter;
     lcmFile["ruleset"] = (int) ruleset;
     lcmFile["roll_automatically"] = rollAutomatically;
+    lcmFile["character_count"] = charactersObject.size();
+    lcmFile["characters"] = charactersObject;
 
-    QJsonObject charactersObject;
-    for (auto i = 0; i < tableData.size(); i++) {
-        const auto& row = tableData.at(i);
-        // Character values
-        QJsonObject singleCharacterObject;
-        singleCharacterObject["name"] = row.at(0).toString();
-        singleCharacterObject["initiative"] = row.at(1).toInt();
-        singleCharacterObject["modifier"] = row.at(2).toInt();
-        singleCharacterObject["hp"] = row.at(3).toInt();
-        singleCharacterObject["is_enemy"] = row.at(4).toBool();
-
-        // Additional info
-        QJsonObject additionalInfoObject;
-        auto addInfo = row.at(5).value<AdditionalInfoData>();
-        additionalInfoObject["main_info"] = addInfo.mainInfoText;
-
-        // Status effects for additional info
-        QJsonObject statusEffectsObject;
-        for (auto j = 0; j < addInfo.statusEffects.size(); j++) {
-            const auto& statusEffect = addInfo.statusEffects.at(j);
-            QJsonObject singleEffectObject;
-            singleEffectObject["name"] = statusEffect.name;
-            singleEffectObject["duration"] = (int) statusEffect.duration;
-            singleEffectObject["is_permanent"] = statusEffect.isPermanent;
-
-            statusEffectsObject[QString::number(j)] = singleEffectObject;
+    return lcmFile;
+}
+
+
+bool
+TableFileHandler::writeTableObject(const QJsonObject& tableObject, const QString& fileName)
+{
+    TRACE_SCOPE("TableFileHandler::writeTableObject");
+
+    // QJsonDocument sorts the keys, which would put the characters first. So the combat stats
+    // are written on their own, then the characters are appended with the same indentation
+    auto headerObject = tableObject;
+    headerObject.remove("characters");
+    auto byteArray = QJsonDocument(headerObject).toJson();
+    // Remove the closing bracket
+    byteArray.chop(3);
+
+    auto charactersArray = QJsonDocument(tableObject.value("characters").toObject()).toJson();
+    charactersArray.chop(1);
+    byteArray.append(",\n    \"characters\": " + charactersArray.replace('\n', "\n    ") + "\n}\n");
+
+    // Write to a temporary file first, the existing file is only replaced if everything has been written
+    QSaveFile fileOut(fileName);
+    if (!fileOut.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    if (fileOut.write(byteArray) == -1) {
+        fileOut.cancelWriting();
+        return false;
+    }
+    return fileOut.commit();
+}
+
+
+TableFileHandler::TableHeader
+TableFileHandler::readTableHeader(const QString& fileName)
+{
+    TRACE_SCOPE("TableFileHandler::readTableHeader");
+
+    TableHeader tableHeader;
+    const auto setTableHeader = [&tableHeader] (const QJsonObject& headerObject, int characterCount) {
+        tableHeader.status = 0;
+        tableHeader.rowEntered = headerObject.value("row_entered").toInt();
+        tableHeader.roundCounter = headerObject.value("round_counter").toInt();
+        tableHeader.ruleset = static_cast<RuleSettings::Ruleset>(headerObject.value("ruleset").toInt());
+        tableHeader.rollAutomatically = headerObject.value("roll_automatically").toBool();
+        tableHeader.characterCount = characterCount;
+    };
+
+    QFile fileIn(fileName);
+    if (!fileIn.open(QIODevice::ReadOnly)) {
+        return tableHeader;
+    }
+
+    // Read chunks until the characters start
+    QByteArray byteArray;
+    qsizetype charactersIndex = -1;
+    while (charactersIndex == -1 && !fileIn.atEnd() && byteArray.size() < HEADER_SIZE_LIMIT) {
+        byteArray.append(fileIn.read(HEADER_CHUNK_SIZE));
+        charactersIndex = byteArray.indexOf("\"characters\"");
+    }
+
+    if (charactersIndex != -1) {
+        // Cut off the characters and close the object again
+        auto headerArray = byteArray.left(charactersIndex).trimmed();
+        if (headerArray.endsWith(',')) {
+            headerArray.chop(1);
         }
-        additionalInfoObject["status_effects"] = statusEffectsObject;
-        singleCharacterObject["additional_info"] = additionalInfoObject;
+        headerArray.append('}');
 
-        charactersObject[QString::number(i)] = singleCharacterObject;
+        const auto headerObject = QJsonDocument::fromJson(headerArray).object();
+        if (headerObject.contains("row_entered") && headerObject.contains("round_counter") && headerObject.contains("ruleset") &&
+            headerObject.contains("roll_automatically") && headerObject.contains("character_count")) {
+            setTableHeader(headerObject, headerObject.value("character_count").toInt());
+            return tableHeader;
+        }
     }
-    lcmFile["characters"] = charactersObject;
 
-    // Write to file
-    auto byteArray = QJsonDocument(lcmFile).toJson();
-    QFile fileOut(fileName);
-    fileOut.open(QIODevice::WriteOnly);
-    return fileOut.write(byteArray) != -1;
+    // Tables stored by older versions have the characters in front, so they have to be parsed completely
+    TableFileHandler tableFileHandler;
+    tableHeader.status = tableFileHandler.getStatus(fileName);
+    if (tableHeader.status == 0) {
+        const auto& tableObject = tableFileHandler.getData();
+        setTableHeader(tableObject, tableObject.value("characters").toObject().size());
+    }
+    return tableHeader;
 }
 
 
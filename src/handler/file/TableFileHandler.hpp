@@ -1,22 +1,64 @@
 #pragma once
 
 #include "BaseFileHandler.hpp"
+#include "CharacterHandler.hpp"
 #include "RuleSettings.hpp"
 
 // This class handles the saving and opening of csv table data
 class TableFileHandler : public BaseFileHandler {
 public:
-    // Write the table to an lcm file
+    // Combat stats stored in front of the characters
+    struct TableHeader {
+        // Same codes as used by getStatus
+        int                   status{ 2 };
+        unsigned int          rowEntered{ 0 };
+        unsigned int          roundCounter{ 1 };
+        RuleSettings::Ruleset ruleset{ RuleSettings::Ruleset::PATHFINDER_1E_DND_35E };
+        bool                  rollAutomatically{ false };
+        int                   characterCount{ 0 };
+    };
+
+    // Write the table to an lcm file. The file is replaced atomically, so a failed
+    // write never corrupts an already existing file. Does not touch the handler's data,
+    // so it is safe to call from a worker thread
     [[nodiscard]] bool
-    writeToFile(const QVector<QVector<QVariant> >& tableData,
-                const QString&                     fileName,
-                unsigned int                       rowEntered,
-                unsigned int                       roundCounter,
-                const RuleSettings::Ruleset&       ruleset,
-                bool                               rollAutomatically) const;
+    writeToFile(const QVector<CharacterHandler::Character>& tableData,
+                const QString&                              fileName,
+                unsigned int                                rowEntered,
+                unsigned int                                roundCounter,
+                const RuleSettings::Ruleset&                ruleset,
+                bool                                        rollAutomatically) const;
+
+    // Convert a single table row into the json object stored for a character
+    [[nodiscard]] static QJsonObject
+    createCharacterObject(const CharacterHandler::Character& character);
+
+    // Assemble the main lcm object out of the combat stats and the stored characters
+    [[nodiscard]] static QJsonObject
+    createTableObject(const QJsonObject&           charactersObject,
+                      unsigned int                 rowEntered,
+                      unsigned int                 roundCounter,
+                      const RuleSettings::Ruleset& ruleset,
+                      bool                         rollAutomatically);
+
+    // Write an lcm object, replacing an existing file atomically. The combat stats
+    // are written in front of the characters, so they can be read on their own
+    [[nodiscard]] static bool
+    writeTableObject(const QJsonObject& tableObject,
+                     const QString&     fileName);
+
+    // Read only the combat stats, stopping before the characters. Does not touch the
+    // handler's data, so it is safe to call from a worker thread
+    [[nodiscard]] static TableHeader
+    readTableHeader(const QString& fileName);
 
 private:
     // Checks if a loaded lcm file is in the right format
     bool
     checkFileFormat() const override;
+
+private:
+    static constexpr int HEADER_CHUNK_SIZE = 512;
+    // Stop looking for the characters if the header is unexpectedly large
+    static constexpr int HEADER_SIZE_LIMIT = 16384;
 };
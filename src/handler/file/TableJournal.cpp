@@ -0,0 +1,336 @@
+#include "TableJournal.hpp"
+
+#include "TableFileHandler.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+// Stored names of the operation types, in the order of the enum
+const std::array<QString, 5> OPERATION_TYPES{ "set", "insert", "remove", "move", "order" };
+
+// Used for the journaled characters as well as for their json objects while recovering
+template<typename T>
+void
+applyOperation(QVector<T>& rows, TableJournal::Operation::Type type, int row, int targetRow,
+               const QVector<int>& sourceRows, const T& value)
+{
+    switch (type) {
+    case TableJournal::Operation::Type::SET:
+        if (row >= 0 && row < rows.size()) {
+            rows[row] = value;
+        }
+        return;
+    case TableJournal::Operation::Type::INSERT:
+        if (row >= 0 && row <= rows.size()) {
+            rows.insert(row, value);
+        }
+        return;
+    case TableJournal::Operation::Type::REMOVE:
+        if (row >= 0 && row < rows.size()) {
+            rows.remove(row);
+        }
+        return;
+    case TableJournal::Operation::Type::MOVE:
+        if (row >= 0 && row < rows.size() && targetRow >= 0 && targetRow < rows.size()) {
+            rows.move(row, targetRow);
+        }
+        return;
+    case TableJournal::Operation::Type::ORDER: {
+        if (sourceRows.size() != rows.size()) {
+            return;
+        }
+        QVector<T> orderedRows;
+        orderedRows.reserve(rows.size());
+        for (const auto sourceRow : sourceRows) {
+            if (sourceRow < 0 || sourceRow >= rows.size()) {
+                return;
+            }
+            orderedRows.push_back(rows.at(sourceRow));
+        }
+        rows = orderedRows;
+        return;
+    }
+    }
+}
+}
+
+
+TableJournal::TableJournal(const QString& directory)
+{
+    QDir().mkpath(directory);
+    m_checkpointFileName = directory + "/autosave.lcm";
+    m_journalFileName = directory + "/autosave.journal";
+
+    // A single writer keeps the records in order
+    m_writerPool.setMaxThreadCount(1);
+}
+
+
+TableJournal::~TableJournal()
+{
+    waitForWrites();
+}
+
+
+void
+TableJournal::start(const QVector<CharacterHandler::Character>& tableData,
+                    unsigned int                                rowEntered,
+                    unsigned int                                roundCounter,
+                    const RuleSettings::Ruleset&                ruleset,
+                    bool                                        rollAutomatically)
+{
+    m_journaledRows = tableData;
+    m_rowEntered = rowEntered;
+    m_roundCounter = roundCounter;
+    m_ruleset = ruleset;
+    m_rollAutomatically = rollAutomatically;
+    m_sequence++;
+
+    writeCheckpoint();
+}
+
+
+void
+TableJournal::append(const QVector<Operation>& operations,
+                     unsigned int              rowEntered,
+                     unsigned int              roundCounter)
+{
+    if (operations.isEmpty() && rowEntered == m_rowEntered && roundCounter == m_roundCounter) {
+        return;
+    }
+
+    for (const auto& operation : operations) {
+        applyOperation(m_journaledRows, operation.type, operation.row, operation.targetRow, operation.sourceRows, operation.character);
+    }
+    m_rowEntered = rowEntered;
+    m_roundCounter = roundCounter;
+    m_sequence++;
+
+    // Compact everything into a new checkpoint if the journal gets too long
+    if (++m_recordCount >= COMPACTION_INTERVAL) {
+        writeCheckpoint();
+        return;
+    }
+
+    // Only the operations are serialized, so the size of a record does not depend on the table size
+    QJsonArray operationsArray;
+    for (const auto& operation : operations) {
+        operationsArray.append(createOperationObject(operation));
+    }
+
+    QJsonObject recordObject;
+    recordObject["row_entered"] = (int) rowEntered;
+    recordObject["round_counter"] = (int) roundCounter;
+    recordObject["sequence"] = m_sequence;
+    recordObject["operations"] = operationsArray;
+    // One compact record per line
+    const auto record = QJsonDocument(recordObject).toJson(QJsonDocument::Compact) + '\n';
+
+    m_writerPool.start([journalFileName = m_journalFileName, record] {
+        QFile journalFile(journalFileName);
+        if (journalFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            journalFile.write(record);
+        }
+    });
+}
+
+
+TableJournal::Operation
+TableJournal::createOrderOperation(const QVector<int>& sourceRows)
+{
+    Operation operation;
+    operation.type = Operation::Type::ORDER;
+    operation.sourceRows = sourceRows;
+
+    // Find the range of rows which changed their position
+    auto first = 0;
+    while (first < sourceRows.size() && sourceRows.at(first) == first) {
+        first++;
+    }
+    auto last = (int) sourceRows.size() - 1;
+    while (last > first && sourceRows.at(last) == last) {
+        last--;
+    }
+    if (first >= last) {
+        return operation;
+    }
+
+    // Either the first row of the range moved to its end and the others moved up, or the other way round
+    auto isMovedDown = sourceRows.at(last) == first;
+    auto isMovedUp = sourceRows.at(first) == last;
+    for (auto i = first; i < last; i++) {
+        isMovedDown = isMovedDown && sourceRows.at(i) == i + 1;
+        isMovedUp = isMovedUp && sourceRows.at(i + 1) == i;
+    }
+    if (!isMovedDown && !isMovedUp) {
+        return operation;
+    }
+
+    operation.type = Operation::Type::MOVE;
+    operation.row = isMovedDown ? first : last;
+    operation.targetRow = isMovedDown ? last : first;
+    operation.sourceRows.clear();
+    return operation;
+}
+
+
+void
+TableJournal::clear()
+{
+    m_journaledRows.clear();
+    m_recordCount = 0;
+
+    m_writerPool.start([checkpointFileName = m_checkpointFileName, journalFileName = m_journalFileName] {
+        QFile::remove(journalFileName);
+        QFile::remove(checkpointFileName);
+    });
+}
+
+
+void
+TableJournal::waitForWrites()
+{
+    m_writerPool.waitForDone();
+}
+
+
+bool
+TableJournal::hasRecoverableData() const
+{
+    return QFile::exists(m_checkpointFileName);
+}
+
+
+bool
+TableJournal::recover(QJsonObject& tableObject) const
+{
+    TableFileHandler tableFileHandler;
+    if (tableFileHandler.getStatus(m_checkpointFileName) != 0) {
+        return false;
+    }
+    tableObject = tableFileHandler.getData();
+    // Records up to this one are already contained in the checkpoint
+    const auto checkpointSequence = tableObject.value("journal_sequence").toInt();
+    tableObject.remove("journal_sequence");
+
+    QFile journalFile(m_journalFileName);
+    if (!journalFile.open(QIODevice::ReadOnly)) {
+        // No changes since the last checkpoint
+        return true;
+    }
+
+    // The operations are applied to the rows in order, so they are stored in a vector until all records are read
+    const auto charactersObject = tableObject.value("characters").toObject();
+    QVector<QJsonValue> rows;
+    rows.reserve(charactersObject.size());
+    for (auto i = 0; charactersObject.contains(QString::number(i)); i++) {
+        rows.push_back(charactersObject.value(QString::number(i)));
+    }
+
+    while (!journalFile.atEnd()) {
+        QJsonParseError parseError;
+        const auto document = QJsonDocument::fromJson(journalFile.readLine(), &parseError);
+        // A crash while appending might have left an incomplete last record
+        if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+            break;
+        }
+        // The journal is only removed after a newer checkpoint has been stored, so it might still contain older records
+        if (const auto recordObject = document.object();
+            !recordObject.contains("sequence") || recordObject.value("sequence").toInt() > checkpointSequence) {
+            applyRecord(rows, tableObject, recordObject);
+        }
+    }
+
+    QJsonObject recoveredCharactersObject;
+    for (auto i = 0; i < rows.size(); i++) {
+        recoveredCharactersObject[QString::number(i)] = rows.at(i);
+    }
+    tableObject["characters"] = recoveredCharactersObject;
+    tableObject["character_count"] = (int) recoveredCharactersObject.size();
+    return true;
+}
+
+
+void
+TableJournal::writeCheckpoint()
+{
+    QJsonObject charactersObject;
+    for (auto i = 0; i < m_journaledRows.size(); i++) {
+        charactersObject[QString::number(i)] = TableFileHandler::createCharacterObject(m_journaledRows.at(i));
+    }
+    auto tableObject = TableFileHandler::createTableObject(charactersObject, m_rowEntered, m_roundCounter,
+                                                           m_ruleset, m_rollAutomatically);
+    tableObject["journal_sequence"] = m_sequence;
+    m_recordCount = 0;
+
+    m_writerPool.start([tableObject, checkpointFileName = m_checkpointFileName, journalFileName = m_journalFileName] {
+        // The old records are only dropped once a checkpoint containing their changes has been stored.
+        // Until then, recovering skips them by their sequence number
+        if (TableFileHandler::writeTableObject(tableObject, checkpointFileName)) {
+            QFile::remove(journalFileName);
+        }
+    });
+}
+
+
+void
+TableJournal::applyRecord(QVector<QJsonValue>& rows, QJsonObject& tableObject, const QJsonObject& recordObject)
+{
+    const auto operationsArray = recordObject.value("operations").toArray();
+    for (const auto& operationValue : operationsArray) {
+        const auto operationObject = operationValue.toObject();
+        const auto typeIt = std::find(OPERATION_TYPES.begin(), OPERATION_TYPES.end(), operationObject.value("type").toString());
+        if (typeIt == OPERATION_TYPES.end()) {
+            continue;
+        }
+
+        QVector<int> sourceRows;
+        for (const auto& sourceRow : operationObject.value("source_rows").toArray()) {
+            sourceRows.push_back(sourceRow.toInt());
+        }
+        applyOperation(rows, static_cast<Operation::Type>(typeIt - OPERATION_TYPES.begin()), operationObject.value("row").toInt(),
+                       operationObject.value("target_row").toInt(), sourceRows, operationObject.value("character"));
+    }
+
+    tableObject["row_entered"] = recordObject.value("row_entered");
+    tableObject["round_counter"] = recordObject.value("round_counter");
+}
+
+
+QJsonObject
+TableJournal::createOperationObject(const Operation& operation)
+{
+    QJsonObject operationObject;
+    operationObject["type"] = OPERATION_TYPES.at(static_cast<int>(operation.type));
+
+    switch (operation.type) {
+    case Operation::Type::SET:
+    case Operation::Type::INSERT:
+        operationObject["row"] = operation.row;
+        operationObject["character"] = TableFileHandler::createCharacterObject(operation.character);
+        break;
+    case Operation::Type::REMOVE:
+        operationObject["row"] = operation.row;
+        break;
+    case Operation::Type::MOVE:
+        operationObject["row"] = operation.row;
+        operationObject["target_row"] = operation.targetRow;
+        break;
+    case Operation::Type::ORDER: {
+        QJsonArray sourceRowsArray;
+        for (const auto sourceRow : operation.sourceRows) {
+            sourceRowsArray.append(sourceRow);
+        }
+        operationObject["source_rows"] = sourceRowsArray;
+        break;
+    }
+    }
+    return operationObject;
+}
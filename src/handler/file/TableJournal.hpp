@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CharacterHandler.hpp"
+#include "RuleSettings.hpp"
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QThreadPool>
+#include <QVector>
+
+// This class handles the autosave of an active combat. Every table change is appended to a journal
+// as a compact record containing only the row operations. From time to time, the journal is compacted
+// into a full lcm checkpoint. All file operations are done in order by a single background writer.
+class TableJournal {
+public:
+    // Inserted, removed and moved rows are stored as operations, so the following rows are not rewritten
+    struct Operation {
+        enum class Type {
+            SET,
+            INSERT,
+            REMOVE,
+            MOVE,
+            ORDER
+        };
+
+        Type                        type{ Type::SET };
+        int                         row{ 0 };
+        // New index of a moved row
+        int                         targetRow{ 0 };
+        // Old index of every row after reordering
+        QVector<int>                sourceRows{};
+        // Set or inserted character
+        CharacterHandler::Character character{};
+    };
+
+public:
+    explicit
+    TableJournal(const QString& directory);
+
+    ~TableJournal();
+
+    // Write a full checkpoint and start a new, empty journal
+    void
+    start(const QVector<CharacterHandler::Character>& tableData,
+          unsigned int                                rowEntered,
+          unsigned int                                roundCounter,
+          const RuleSettings::Ruleset&                ruleset,
+          bool                                        rollAutomatically);
+
+    // Append a record with the operations applied since the last record
+    void
+    append(const QVector<Operation>& operations,
+           unsigned int              rowEntered,
+           unsigned int              roundCounter);
+
+    // A single move if only one row changed its position, otherwise a reordering of all rows
+    [[nodiscard]] static Operation
+    createOrderOperation(const QVector<int>& sourceRows);
+
+    // Remove checkpoint and journal, used if a combat has been closed regularly
+    void
+    clear();
+
+    // Block until all pending records have been written
+    void
+    waitForWrites();
+
+    [[nodiscard]] bool
+    hasRecoverableData() const;
+
+    // Recreate the last table state in the lcm format using the checkpoint and the journal
+    [[nodiscard]] bool
+    recover(QJsonObject& tableObject) const;
+
+private:
+    void
+    writeCheckpoint();
+
+    // Apply the operations of a record to the rows of a recovered table
+    static void
+    applyRecord(QVector<QJsonValue>& rows,
+                QJsonObject&         tableObject,
+                const QJsonObject&   recordObject);
+
+    [[nodiscard]] static QJsonObject
+    createOperationObject(const Operation& operation);
+
+private:
+    QThreadPool m_writerPool;
+
+    // Characters as they are stored after the last record
+    QVector<CharacterHandler::Character> m_journaledRows;
+
+    QString m_checkpointFileName;
+    QString m_journalFileName;
+
+    RuleSettings::Ruleset m_ruleset{ RuleSettings::Ruleset::PATHFINDER_1E_DND_35E };
+    bool m_rollAutomatically{ false };
+
+    unsigned int m_rowEntered{ 0 };
+    unsigned int m_roundCounter{ 1 };
+
+    int m_recordCount{ 0 };
+    // Number of the last change, stored with every record and checkpoint
+    int m_sequence{ 0 };
+
+    static constexpr int COMPACTION_INTERVAL = 100;
+};
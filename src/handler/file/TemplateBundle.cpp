@@ -0,0 +1,293 @@
+#include "TemplateBundle.hpp"
+
+#include "CharFileHandler.hpp"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+#include <algorithm>
+
+TemplateBundle::TemplateBundle(const QString& fileName) :
+    m_file(fileName)
+{
+}
+
+
+bool
+TemplateBundle::open(bool isReadOnly)
+{
+    m_records.clear();
+    m_outdatedSize = 0;
+
+    if (!m_file.isOpen() && !m_file.open(isReadOnly ? QIODevice::ReadOnly : QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    QDataStream stream(&m_file);
+    stream.setVersion(QDataStream::Qt_5_12);
+
+    m_file.seek(0);
+    if (m_file.size() == 0 && m_file.isWritable()) {
+        // New bundle
+        stream << BUNDLE_MAGIC << BUNDLE_VERSION;
+        return m_file.flush();
+    }
+    // Do not overwrite other files
+    if (m_file.size() < HEADER_SIZE) {
+        m_file.close();
+        return false;
+    }
+
+    quint32 magic{ 0 }, version{ 0 };
+    stream >> magic >> version;
+    if (magic != BUNDLE_MAGIC || version != BUNDLE_VERSION) {
+        m_file.close();
+        return false;
+    }
+
+    // Only the record headers are read, the characters themselves are skipped
+    auto offset = HEADER_SIZE;
+    while (offset < m_file.size()) {
+        m_file.seek(offset);
+
+        quint32 recordSize{ 0 };
+        quint8 type{ 0 };
+        QString name;
+        stream >> recordSize;
+        if (stream.status() != QDataStream::Ok || offset + (qint64) sizeof(quint32) + recordSize > m_file.size()) {
+            break;
+        }
+        stream >> type >> name;
+        if (stream.status() != QDataStream::Ok) {
+            break;
+        }
+
+        const Record record{ offset, (qint64) sizeof(quint32) + recordSize };
+        if (const auto it = m_records.constFind(name); it != m_records.constEnd()) {
+            m_outdatedSize += it->size;
+        }
+        if (type == RECORD_CHARACTER) {
+            m_records.insert(name, record);
+        } else {
+            m_records.remove(name);
+            m_outdatedSize += record.size;
+        }
+        offset += record.size;
+    }
+
+    // Drop the remains of an interrupted append, a read-only bundle just ignores them
+    if (offset < m_file.size() && m_file.isWritable()) {
+        m_file.resize(offset);
+    }
+    return true;
+}
+
+
+bool
+TemplateBundle::read(const QString& name, CharacterHandler::Character& character)
+{
+    const auto it = m_records.constFind(name);
+    if (it == m_records.constEnd() || !m_file.seek(it->offset)) {
+        return false;
+    }
+
+    QDataStream stream(&m_file);
+    stream.setVersion(QDataStream::Qt_5_12);
+
+    quint32 recordSize{ 0 };
+    quint8 type{ 0 };
+    QString mainInfoText;
+    stream >> recordSize >> type >> character.name >> character.initiative >> character.modifier >> character.hp
+    >> character.isEnemy >> mainInfoText;
+    character.additionalInfoData = AdditionalInfoData{ {}, mainInfoText };
+
+    return stream.status() == QDataStream::Ok;
+}
+
+
+bool
+TemplateBundle::append(const CharacterHandler::Character& character)
+{
+    return writeRecord(RECORD_CHARACTER, character.name, createPayload(character));
+}
+
+
+bool
+TemplateBundle::remove(const QString& name)
+{
+    if (!m_records.contains(name)) {
+        return false;
+    }
+    return writeRecord(RECORD_TOMBSTONE, name, QByteArray());
+}
+
+
+bool
+TemplateBundle::compact()
+{
+    // Keep the records in their current order
+    auto records = m_records.values();
+    std::sort(records.begin(), records.end(), [] (const auto& first, const auto& second) {
+        return first.offset < second.offset;
+    });
+
+    QSaveFile fileOut(m_file.fileName());
+    if (!fileOut.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream stream(&fileOut);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << BUNDLE_MAGIC << BUNDLE_VERSION;
+
+    for (const auto& record : records) {
+        m_file.seek(record.offset);
+        const auto recordData = m_file.read(record.size);
+        if (recordData.size() != record.size || fileOut.write(recordData) == -1) {
+            fileOut.cancelWriting();
+            return false;
+        }
+    }
+
+    // The file has to be closed before it can be replaced
+    m_file.close();
+    const auto success = fileOut.commit();
+    return open() && success;
+}
+
+
+int
+TemplateBundle::importDirectory(const QString& directory)
+{
+    auto importedCount = 0;
+    const auto fileInfos = QDir(directory).entryInfoList({ "*.char" }, QDir::Files);
+    for (const auto& fileInfo : fileInfos) {
+        CharacterHandler::Character character;
+        if (CharFileHandler::readCharacter(fileInfo.filePath(), character) == 0 && append(character)) {
+            importedCount++;
+        }
+    }
+    return importedCount;
+}
+
+
+int
+TemplateBundle::exportDirectory(const QString& directory)
+{
+    QDir().mkpath(directory);
+    const auto absoluteDirectory = QDir(directory).absolutePath();
+
+    auto exportedCount = 0;
+    for (const auto& name : getNames()) {
+        // Shared bundles must not write anywhere else
+        const auto filePath = QDir(directory).filePath(name + ".char");
+        if (name.isEmpty() || name.contains('/') || name.contains('\\') || name.startsWith("..") ||
+            QFileInfo(filePath).absolutePath() != absoluteDirectory) {
+            continue;
+        }
+
+        CharacterHandler::Character character;
+        if (!read(name, character)) {
+            continue;
+        }
+
+        QSaveFile fileOut(filePath);
+        if (fileOut.open(QIODevice::WriteOnly) &&
+            fileOut.write(QJsonDocument(CharFileHandler::createCharacterObject(character)).toJson()) != -1 && fileOut.commit()) {
+            exportedCount++;
+        }
+    }
+    return exportedCount;
+}
+
+
+bool
+TemplateBundle::writeBundle(const QString& fileName, const QVector<CharacterHandler::Character>& characters)
+{
+    QSaveFile fileOut(fileName);
+    if (!fileOut.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream stream(&fileOut);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << BUNDLE_MAGIC << BUNDLE_VERSION;
+
+    for (const auto& character : characters) {
+        if (fileOut.write(createRecordData(RECORD_CHARACTER, character.name, createPayload(character))) == -1) {
+            fileOut.cancelWriting();
+            return false;
+        }
+    }
+    return fileOut.commit();
+}
+
+
+bool
+TemplateBundle::writeRecord(quint8 type, const QString& name, const QByteArray& payload)
+{
+    if (!m_file.isOpen() || !m_file.isWritable()) {
+        return false;
+    }
+
+    // Size and record are written in one go, so an interrupted append is detected on the next open
+    const auto recordData = createRecordData(type, name, payload);
+    const auto offset = m_file.size();
+    if (!m_file.seek(offset) || m_file.write(recordData) == -1 || !m_file.flush()) {
+        return false;
+    }
+
+    const Record record{ offset, recordData.size() };
+    if (const auto it = m_records.constFind(name); it != m_records.constEnd()) {
+        m_outdatedSize += it->size;
+    }
+    if (type == RECORD_CHARACTER) {
+        m_records.insert(name, record);
+    } else {
+        m_records.remove(name);
+        m_outdatedSize += record.size;
+    }
+
+    compactIfNeeded();
+    return true;
+}
+
+
+QByteArray
+TemplateBundle::createRecordData(quint8 type, const QString& name, const QByteArray& payload)
+{
+    QByteArray recordData;
+    QDataStream stream(&recordData, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << type << name;
+    recordData.append(payload);
+
+    QByteArray sizeData;
+    QDataStream sizeStream(&sizeData, QIODevice::WriteOnly);
+    sizeStream << (quint32) recordData.size();
+
+    return sizeData + recordData;
+}
+
+
+QByteArray
+TemplateBundle::createPayload(const CharacterHandler::Character& character)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << character.initiative << character.modifier << character.hp << character.isEnemy
+           << character.additionalInfoData.mainInfoText;
+    return payload;
+}
+
+
+void
+TemplateBundle::compactIfNeeded()
+{
+    if (m_outdatedSize >= COMPACTION_MIN_SIZE && m_outdatedSize * 2 > m_file.size()) {
+        // A failed compaction leaves the bundle as it is, so it can be retried later
+        [[maybe_unused]] const auto compacted = compact();
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CharacterHandler.hpp"
+
+#include <QFile>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+// This class stores character templates in a single bundle file instead of one file per template.
+// The bundle is append-only: every change adds a record of the form [size][type][name][payload],
+// removals add a tombstone record. An in-memory index maps every name to its latest record,
+// so lookups are done with a single seek. Outdated records are dropped by compacting the bundle.
+class TemplateBundle {
+public:
+    explicit
+    TemplateBundle(const QString& fileName);
+
+    // Open or create the bundle and index its records. An incompletely written last record is discarded,
+    // files which are no bundle are left untouched. A read-only bundle is never modified
+    [[nodiscard]] bool
+    open(bool isReadOnly = false);
+
+    [[nodiscard]] bool
+    contains(const QString& name) const
+    {
+        return m_records.contains(name);
+    }
+
+    [[nodiscard]] QStringList
+    getNames() const
+    {
+        return m_records.keys();
+    }
+
+    [[nodiscard]] bool
+    read(const QString&               name,
+         CharacterHandler::Character& character);
+
+    // Store a character, replacing an existing one with the same name
+    [[nodiscard]] bool
+    append(const CharacterHandler::Character& character);
+
+    [[nodiscard]] bool
+    remove(const QString& name);
+
+    // Rewrite the bundle with the current records only
+    [[nodiscard]] bool
+    compact();
+
+    // Add all templates stored in the loose .char layout, returns the number of imported templates
+    int
+    importDirectory(const QString& directory);
+
+    // Write every template as a single .char file, returns the number of exported templates.
+    // Templates whose name would lead outside of the directory are skipped
+    int
+    exportDirectory(const QString& directory);
+
+    // Write a new bundle containing the given characters, an existing file is only replaced if all of them are written
+    [[nodiscard]] static bool
+    writeBundle(const QString&                                  fileName,
+                const QVector<CharacterHandler::Character>& characters);
+
+private:
+    [[nodiscard]] bool
+    writeRecord(quint8            type,
+                const QString&    name,
+                const QByteArray& payload);
+
+    // Size field followed by the record itself
+    [[nodiscard]] static QByteArray
+    createRecordData(quint8            type,
+                     const QString&    name,
+                     const QByteArray& payload);
+
+    [[nodiscard]] static QByteArray
+    createPayload(const CharacterHandler::Character& character);
+
+    // Compact if most of the bundle consists of outdated records
+    void
+    compactIfNeeded();
+
+private:
+    struct Record {
+        qint64 offset;
+        // Size including the size field itself
+        qint64 size;
+    };
+
+    QFile m_file;
+    // Names mapped to their latest record
+    QHash<QString, Record> m_records;
+
+    // Size of all replaced records and tombstones
+    qint64 m_outdatedSize{ 0 };
+
+    static constexpr quint32 BUNDLE_MAGIC = 0x4c434d42;
+    static constexpr quint32 BUNDLE_VERSION = 1;
+    static constexpr qint64 HEADER_SIZE = 8;
+
+    static constexpr quint8 RECORD_CHARACTER = 0;
+    static constexpr quint8 RECORD_TOMBSTONE = 1;
+
+    static constexpr qint64 COMPACTION_MIN_SIZE = 64 * 1024;
+};
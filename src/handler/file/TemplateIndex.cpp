@@ -0,0 +1,200 @@
+#include "TemplateIndex.hpp"
+
+#include "CharFileHandler.hpp"
+#include "UtilsTrace.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrentMap>
+
+TemplateIndex::TemplateIndex(const QString& directory) :
+    m_directory(directory),
+    // "dir/chars/" is indexed in "dir/chars.index"
+    m_indexFileName(QDir::cleanPath(directory) + ".index")
+{
+}
+
+
+void
+TemplateIndex::load()
+{
+    TRACE_SCOPE("TemplateIndex::load");
+
+    const auto changedFiles = validate();
+    const auto parseResults = QtConcurrent::blockingMapped<QList<ParseResult> >(changedFiles, &TemplateIndex::parseTemplate);
+    for (const auto& parseResult : parseResults) {
+        insert(parseResult);
+    }
+
+    if (m_isModified) {
+        write();
+    }
+}
+
+
+QStringList
+TemplateIndex::validate()
+{
+    const auto indexRead = read();
+    const auto directoryModified = QFileInfo(m_directory).lastModified().toMSecsSinceEpoch();
+    // Adding, removing or renaming a template changes the directory modification time.
+    // If it is unchanged, the index can be used without looking at a single template
+    if (indexRead && directoryModified == m_directoryModified &&
+        m_indexWritten - m_directoryModified > MODIFICATION_TIME_RESOLUTION) {
+        return {};
+    }
+    return update();
+}
+
+
+QStringList
+TemplateIndex::update()
+{
+    TRACE_SCOPE("TemplateIndex::update");
+
+    // Stat all templates, only new or changed ones have to be parsed
+    const auto directoryModified = QFileInfo(m_directory).lastModified().toMSecsSinceEpoch();
+
+    QMap<QString, Entry> entries;
+    QStringList changedFiles;
+    const auto fileInfos = QDir(m_directory).entryInfoList({ "*.char" }, QDir::Files);
+    for (const auto& fileInfo : fileInfos) {
+        const auto modified = fileInfo.lastModified().toMSecsSinceEpoch();
+        if (const auto it = m_entries.constFind(fileInfo.fileName());
+            it != m_entries.constEnd() && it->modified == modified && it->size == fileInfo.size()) {
+            entries.insert(fileInfo.fileName(), *it);
+            continue;
+        }
+        changedFiles.push_back(fileInfo.filePath());
+    }
+
+    m_entries = entries;
+    m_directoryModified = directoryModified;
+    // Store the checked state even if no template has to be parsed
+    m_isModified = true;
+
+    return changedFiles;
+}
+
+
+TemplateIndex::ParseResult
+TemplateIndex::parseTemplate(const QString& filePath)
+{
+    TRACE_SCOPE("TemplateIndex::parseTemplate");
+
+    const QFileInfo fileInfo(filePath);
+
+    ParseResult parseResult;
+    parseResult.fileName = fileInfo.fileName();
+    parseResult.entry.modified = fileInfo.lastModified().toMSecsSinceEpoch();
+    parseResult.entry.size = fileInfo.size();
+    parseResult.isValid = CharFileHandler::readCharacter(filePath, parseResult.entry.character) == 0;
+
+    return parseResult;
+}
+
+
+void
+TemplateIndex::insert(const QString& fileName, const CharacterHandler::Character& character)
+{
+    // The directory time is not updated, so the next load still detects changes made by others
+    const QFileInfo fileInfo(QDir(m_directory).filePath(fileName));
+    m_entries.insert(fileName, Entry{ fileInfo.lastModified().toMSecsSinceEpoch(), fileInfo.size(), character });
+    m_isModified = true;
+}
+
+
+void
+TemplateIndex::insert(const ParseResult& parseResult)
+{
+    if (parseResult.isValid) {
+        m_entries.insert(parseResult.fileName, parseResult.entry);
+        m_isModified = true;
+    }
+}
+
+
+void
+TemplateIndex::remove(const QString& fileName)
+{
+    m_entries.remove(fileName);
+    m_isModified = true;
+}
+
+
+bool
+TemplateIndex::write()
+{
+    TRACE_SCOPE("TemplateIndex::write");
+
+    QSaveFile fileOut(m_indexFileName);
+    if (!fileOut.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    m_indexWritten = QDateTime::currentMSecsSinceEpoch();
+
+    QDataStream stream(&fileOut);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << INDEX_MAGIC << INDEX_VERSION << m_directoryModified << m_indexWritten << (quint32) m_entries.size();
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        const auto& character = it->character;
+        stream << it.key() << it->modified << it->size << character.name << character.initiative << character.modifier
+               << character.hp << character.isEnemy << character.additionalInfoData.mainInfoText;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        fileOut.cancelWriting();
+        return false;
+    }
+    if (!fileOut.commit()) {
+        return false;
+    }
+
+    m_isModified = false;
+    return true;
+}
+
+
+bool
+TemplateIndex::read()
+{
+    TRACE_SCOPE("TemplateIndex::read");
+
+    m_entries.clear();
+    m_isModified = false;
+
+    QFile fileIn(m_indexFileName);
+    if (!fileIn.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&fileIn);
+    stream.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic{ 0 }, version{ 0 }, entryCount{ 0 };
+    stream >> magic >> version;
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION) {
+        return false;
+    }
+    stream >> m_directoryModified >> m_indexWritten >> entryCount;
+
+    for (quint32 i = 0; i < entryCount && stream.status() == QDataStream::Ok; i++) {
+        QString fileName;
+        Entry entry;
+        auto& character = entry.character;
+        stream >> fileName >> entry.modified >> entry.size >> character.name >> character.initiative >> character.modifier
+        >> character.hp >> character.isEnemy >> character.additionalInfoData.mainInfoText;
+        m_entries.insert(fileName, entry);
+    }
+
+    // A broken index is treated like a missing one
+    if (stream.status() != QDataStream::Ok) {
+        m_entries.clear();
+        return false;
+    }
+    return true;
+}
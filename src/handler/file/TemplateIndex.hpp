@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CharacterHandler.hpp"
+
+#include <QMap>
+#include <QString>
+
+// This class caches the parsed character templates in a single index file, which is stored next to
+// the template directory, so writing it does not change the directory itself. The index is validated
+// using modification times, so only new or changed templates have to be parsed again.
+class TemplateIndex {
+public:
+    struct Entry {
+        qint64                      modified{ 0 };
+        qint64                      size{ 0 };
+        CharacterHandler::Character character;
+    };
+
+    struct ParseResult {
+        QString fileName;
+        Entry   entry;
+        // False if the template could not be read or has the wrong format
+        bool    isValid{ false };
+    };
+
+public:
+    explicit
+    TemplateIndex(const QString& directory);
+
+    // Read the index and update it for all templates which changed since it has been written
+    void
+    load();
+
+    // Read the index and drop all entries which are outdated. Returns the paths of all templates
+    // which have to be parsed again, their results have to be inserted before the index is written
+    [[nodiscard]] QStringList
+    validate();
+
+    // Same as validate, but compares the directory against the current entries instead of the stored index
+    [[nodiscard]] QStringList
+    update();
+
+    // Parse a single template, safe to call from a worker thread
+    [[nodiscard]] static ParseResult
+    parseTemplate(const QString& filePath);
+
+    // Update the entry of a template file which has just been written
+    void
+    insert(const QString&                     fileName,
+           const CharacterHandler::Character& character);
+
+    void
+    insert(const ParseResult& parseResult);
+
+    void
+    remove(const QString& fileName);
+
+    // Store the index, replacing the old file atomically
+    bool
+    write();
+
+    [[nodiscard]] const QMap<QString, Entry>&
+    getEntries() const
+    {
+        return m_entries;
+    }
+
+    // True if the entries differ from the stored index
+    [[nodiscard]] bool
+    isModified() const
+    {
+        return m_isModified;
+    }
+
+private:
+    [[nodiscard]] bool
+    read();
+
+private:
+    // File names mapped to the stored entries
+    QMap<QString, Entry> m_entries;
+
+    QString m_directory;
+    QString m_indexFileName;
+
+    // Directory modification time at the last complete check, in ms
+    qint64 m_directoryModified{ -1 };
+    qint64 m_indexWritten{ -1 };
+
+    bool m_isModified{ false };
+
+    static constexpr quint32 INDEX_MAGIC = 0x4c434d49;
+    static constexpr quint32 INDEX_VERSION = 1;
+    // Some file systems only store modification times in seconds. Directory changes made shortly
+    // before the index has been written might share the same time, so these are checked again
+    static constexpr qint64 MODIFICATION_TIME_RESOLUTION = 2000;
+};
@@ -1,18 +1,55 @@
 #include "ui/MainWindow.hpp"
 
+#include "CharFileHandler.hpp"
 #include "CheckBoxStyle.hpp"
+#include "IconCache.hpp"
+#include "TemplateIndex.hpp"
 #include "UtilsGeneral.hpp"
+#include "UtilsTrace.hpp"
 
 #include <QApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFuture>
 #include <QSplashScreen>
 #include <QSettings>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace
+{
+// Reports the time from the start of the process until the main window has been painted for the first time
+class FirstPaintFilter : public QObject {
+public:
+    FirstPaintFilter(const QWidget *mainWindow, const QElapsedTimer& startupTimer) :
+        m_mainWindow(mainWindow),
+        m_startupTimer(startupTimer)
+    {
+    }
+
+    bool
+    eventFilter(QObject *object, QEvent *event) override
+    {
+        if (event->type() == QEvent::Paint && object->isWidgetType() &&
+            static_cast<QWidget*>(object)->window() == m_mainWindow) {
+            qInfo().noquote() << "Startup time until first paint:" << m_startupTimer.elapsed() << "ms";
+            qApp->removeEventFilter(this);
+        }
+        return false;
+    }
+
+private:
+    const QWidget *m_mainWindow;
+    const QElapsedTimer& m_startupTimer;
+};
+}
 
-#include <chrono>
-#include <thread>
 
 int
 main(int argc, char *argv[])
 {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     QApplication app(argc, argv);
     app.setApplicationName("LCM");
     app.setOrganizationName("LCM");
@@ -22,16 +59,38 @@ main(int argc, char *argv[])
     QSettings::setDefaultFormat(QSettings::IniFormat);
 #endif
 
+    // Traces are only recorded if requested via LCM_TRACE
+    Utils::Trace::initialize();
+
     const auto isSystemInDarkMode = Utils::General::isSystemInDarkMode();
     QPixmap pixmap(isSystemInDarkMode ? ":/icons/logos/splash_dark.png" : ":/icons/logos/splash_light.png");
     QSplashScreen splash(pixmap);
     splash.show();
+    app.processEvents();
+
+    // Rasterize the icons of both themes, so they are ready once the main window needs them
+    IconCache::instance().preload(IconCache::getResourceIconFileNames(), app.devicePixelRatio());
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+    // Bring the template index up to date while the main window is created,
+    // so the templates dialog does not have to parse changed files when it is opened
+    CharFileHandler charFileHandler;
+    auto templateIndexFuture = QtConcurrent::run([directory = charFileHandler.getDirectoryString()] {
+        TemplateIndex templateIndex(directory);
+        templateIndex.load();
+    });
 
     MainWindow mainWindow;
+    FirstPaintFilter firstPaintFilter(&mainWindow, startupTimer);
+    if (qEnvironmentVariableIsSet("LCM_STARTUP_TIME")) {
+        app.installEventFilter(&firstPaintFilter);
+    }
     mainWindow.show();
     splash.finish(&mainWindow);
 
-    return app.exec();
+    const auto result = app.exec();
+    templateIndexFuture.waitForFinished();
+    if (Utils::Trace::isEnabled()) {
+        Utils::Trace::writeTraceFile();
+    }
+    return result;
 }
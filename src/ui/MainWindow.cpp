@@ -1,14 +1,18 @@
 #include "MainWindow.hpp"
 
 #include "CombatWidget.hpp"
+#include "IconCache.hpp"
 #include "SettingsDialog.hpp"
+#include "StringWidthCache.hpp"
 #include "UtilsGeneral.hpp"
+#include "UtilsTrace.hpp"
 #include "WelcomeWidget.hpp"
 
 #include <QAction>
 #include <QApplication>
 #include <QCloseEvent>
 #include <QDebug>
+#include <QDir>
 #include <QFileDialog>
 #include <QKeySequence>
 #include <QMenuBar>
@@ -29,7 +33,9 @@ MainWindow::MainWindow()
 
     m_saveAction = new QAction(tr("&Save"), this);
     m_saveAction->setShortcuts(QKeySequence::Save);
-    connect(m_saveAction, &QAction::triggered, this, &MainWindow::saveTable);
+    connect(m_saveAction, &QAction::triggered, this, [this] {
+        saveTable(true);
+    });
 
     m_saveAsAction = new QAction(tr("&Save As..."), this);
     m_saveAsAction->setShortcuts(QKeySequence::SaveAs);
@@ -40,7 +46,7 @@ MainWindow::MainWindow()
         m_saveAsAction->setEnabled(enable);
     });
 
-    auto* const closeAction = new QAction(QIcon(":/icons/menus/close.svg"), tr("&Close"), this);
+    auto* const closeAction = new QAction(IconCache::instance().getIcon(":/icons/menus/close.svg"), tr("&Close"), this);
     closeAction->setShortcuts(QKeySequence::Close);
     connect(closeAction, &QAction::triggered, this, [this] () {
         m_isTableActive ? exitCombat() : QApplication::quit();
@@ -71,9 +77,30 @@ MainWindow::MainWindow()
 
     m_tableFileHandler = std::make_shared<TableFileHandler>();
 
+    m_tableJournal = std::make_unique<TableJournal>(QDir::currentPath() + "/autosave");
+    // Multiple changes in a short time are collected into a single journal record
+    m_autosaveTimer = new QTimer(this);
+    m_autosaveTimer->setSingleShot(true);
+    m_autosaveTimer->setInterval(AUTOSAVE_DELAY);
+    connect(m_autosaveTimer, &QTimer::timeout, this, [this] {
+        // Only the applied operations are journaled, the table itself is not read again
+        if (m_combatWidget) {
+            m_tableJournal->append(m_combatWidget->takeJournalOperations(), m_combatWidget->getRowEntered(),
+                                   m_combatWidget->getRoundCounter());
+        }
+    });
+
+    m_saveFutureWatcher = new QFutureWatcher<bool>(this);
+    connect(m_saveFutureWatcher, &QFutureWatcher<bool>::finished, this, [this] {
+        handleSavedTable(m_saveFutureWatcher->result());
+    });
+
     setMainWindowIcons();
     resize(START_WIDTH, START_HEIGHT);
     setWelcomingWidget();
+
+    // Offer to restore an autosaved Combat as soon as the window is shown
+    QTimer::singleShot(0, this, &MainWindow::recoverAutosavedTable);
 }
 
 
@@ -97,11 +124,23 @@ MainWindow::newCombat()
 
 
 bool
-MainWindow::saveTable()
+MainWindow::saveTable(bool saveAsync)
 {
+    TRACE_SCOPE("MainWindow::saveTable");
+
     if (!isWindowModified()) {
         return false;
     }
+    // Never write to the same file with two workers at once. Wait for the running save,
+    // changes made after its snapshot are written by this one
+    if (m_saveFutureWatcher->isRunning()) {
+        m_saveFutureWatcher->waitForFinished();
+        handleSavedTable(m_saveFutureWatcher->result());
+        // The already running save might have stored everything
+        if (!isWindowModified()) {
+            return true;
+        }
+    }
 
     QString fileName;
     // Save to standard save dir if a new combat has been started
@@ -118,18 +157,19 @@ MainWindow::saveTable()
         // Otherwise, just overwrite the loaded file
         fileName = m_dirSettings.openDir;
     }
-    // Save the table
-    if (m_combatWidget->writeTableToFile(fileName)) {
-        m_isTableSavedInFile = true;
-        m_dirSettings.write(fileName, true);
-        m_fileName = Utils::General::getLCMName(fileName);
 
-        setCombatTitle(false);
-        // Success
+    m_savingFileName = fileName;
+    m_isTableSavedInFileBeforeSaving = m_isTableSavedInFile;
+    m_changeOccuredWhileSaving = false;
+    // Save the table
+    if (saveAsync) {
+        m_saveFutureWatcher->setFuture(m_combatWidget->writeTableToFileAsync(fileName));
         return true;
     }
-    QMessageBox::critical(this, tr("Could not save Table!"), tr("Failed to write file."));
-    return false;
+
+    const auto success = m_combatWidget->writeTableToFile(fileName);
+    handleSavedTable(success);
+    return success;
 }
 
 
@@ -144,11 +184,14 @@ MainWindow::saveAs()
     // Change variables to call the file dialog
     setWindowModified(true);
     m_isTableSavedInFile = false;
-    // Restore old state if the save fails
-    if (!saveTable()) {
+    // Restore old state if no file has been selected
+    if (!saveTable(true)) {
         setWindowModified(saveChangeOccured);
         m_isTableSavedInFile = saveTableInFile;
+        return;
     }
+    // The asynchronous writing might still fail, so the old file is used again in that case
+    m_isTableSavedInFileBeforeSaving = saveTableInFile;
 }
 
 
@@ -156,8 +199,21 @@ void
 MainWindow::openTable()
 {
     const auto fileName = QFileDialog::getOpenFileName(this, "Open Table", m_dirSettings.openDir, ("lcm File(*.lcm)"));
-    // Return if this exact same file is already loaded or if the dialog has been cancelled
-    if ((m_isTableActive && fileName == m_fileDir) || fileName.isEmpty()) {
+    // Return if the dialog has been cancelled
+    if (fileName.isEmpty()) {
+        return;
+    }
+    openTableFile(fileName);
+}
+
+
+void
+MainWindow::openTableFile(const QString& fileName)
+{
+    TRACE_SCOPE("MainWindow::openTableFile");
+
+    // Return if this exact same file is already loaded
+    if (m_isTableActive && fileName == m_fileDir) {
         return;
     }
     // Check if a table is active right now
@@ -191,6 +247,7 @@ MainWindow::openTable()
         m_isTableSavedInFile = true;
         // Save the opened file dir
         m_dirSettings.write(fileName);
+        m_dirSettings.addRecentFile(fileName);
         m_fileName = Utils::General::getLCMName(fileName);
         m_fileDir = fileName;
         setTableWidget(true, false);
@@ -244,6 +301,67 @@ MainWindow::exitCombat()
     }
     setWelcomingWidget();
     m_isTableActive = false;
+
+    m_autosaveTimer->stop();
+    m_tableJournal->clear();
+}
+
+
+void
+MainWindow::recoverAutosavedTable()
+{
+    if (!m_tableJournal->hasRecoverableData()) {
+        return;
+    }
+
+    const auto reply = QMessageBox::question(this, tr("Restore Combat?"),
+                                             tr("LCM has not been closed properly. Do you want to restore the last Combat?"),
+                                             QMessageBox::Yes | QMessageBox::No);
+    if (reply == QMessageBox::Yes) {
+        QJsonObject tableObject;
+        if (m_tableJournal->recover(tableObject)) {
+            m_tableFileHandler->getData() = tableObject;
+            m_isTableSavedInFile = false;
+            m_fileName = QString();
+            m_fileDir = QString();
+            setTableWidget(true, false);
+
+            // The restored Combat is not stored in any file yet
+            setCombatTitle(true);
+            return;
+        }
+        QMessageBox::critical(this, tr("Could not restore Combat!"), tr("The autosaved Combat could not be read."));
+    }
+    m_tableJournal->clear();
+}
+
+
+void
+MainWindow::handleSavedTable(bool success)
+{
+    // Already handled if a synchronous save had to wait for this one
+    if (m_savingFileName.isEmpty()) {
+        return;
+    }
+    const auto fileName = m_savingFileName;
+    m_savingFileName = QString();
+
+    if (!success) {
+        m_isTableSavedInFile = m_isTableSavedInFileBeforeSaving;
+        QMessageBox::critical(this, tr("Could not save Table!"), tr("Failed to write file."));
+        return;
+    }
+
+    m_isTableSavedInFile = true;
+    m_dirSettings.write(fileName, true);
+    m_dirSettings.addRecentFile(fileName);
+    m_fileName = Utils::General::getLCMName(fileName);
+
+    setCombatTitle(false);
+    // Changes made while the worker was writing are not part of the saved file
+    if (m_changeOccuredWhileSaving) {
+        setCombatTitle(true);
+    }
 }
 
 
@@ -252,8 +370,9 @@ MainWindow::setWelcomingWidget()
 {
     setWindowTitle("LCM");
 
-    m_welcomeWidget = new WelcomeWidget(this);
+    m_welcomeWidget = new WelcomeWidget(m_dirSettings.recentFiles, this);
     setCentralWidget(m_welcomeWidget);
+    connect(m_welcomeWidget, &WelcomeWidget::recentFileSelected, this, &MainWindow::openTableFile);
     resize(START_WIDTH, START_HEIGHT);
 
     m_isTableSavedInFile = false;
@@ -264,6 +383,8 @@ MainWindow::setWelcomingWidget()
 void
 MainWindow::setTableWidget(bool isDataStored, bool newCombatStarted)
 {
+    TRACE_SCOPE("MainWindow::setTableWidget");
+
     m_combatWidget = new CombatWidget(m_tableFileHandler, m_additionalSettings, m_ruleSettings, width(), isDataStored, this);
     setCentralWidget(m_combatWidget);
     connect(m_combatWidget, &CombatWidget::exit, this, &MainWindow::exitCombat);
@@ -283,7 +404,11 @@ MainWindow::setTableWidget(bool isDataStored, bool newCombatStarted)
         }
     });
     connect(m_combatWidget, &CombatWidget::changeOccured, this, [this] {
+        if (!m_savingFileName.isEmpty()) {
+            m_changeOccuredWhileSaving = true;
+        }
         setCombatTitle(true);
+        m_autosaveTimer->start();
     });
 
     setCombatTitle(false);
@@ -299,6 +424,12 @@ MainWindow::setTableWidget(bool isDataStored, bool newCombatStarted)
 
     m_isTableActive = true;
     emit setSaveAction(true);
+
+    // Every following change is appended to the autosave journal, the operations creating the table are in the checkpoint
+    m_autosaveTimer->stop();
+    static_cast<void>(m_combatWidget->takeJournalOperations());
+    m_tableJournal->start(m_combatWidget->getCombatTableWidget()->tableDataFromWidget(), m_combatWidget->getRowEntered(),
+                          m_combatWidget->getRoundCounter(), m_ruleSettings.ruleset, m_ruleSettings.rollAutomatical);
 }
 
 
@@ -368,6 +499,11 @@ MainWindow::createRuleChangeMessageBoxText() const
 void
 MainWindow::closeEvent(QCloseEvent *event)
 {
+    // Let a running save finish, so the user is only asked if something is still unsaved
+    if (m_saveFutureWatcher->isRunning()) {
+        m_saveFutureWatcher->waitForFinished();
+        handleSavedTable(m_saveFutureWatcher->result());
+    }
     // Check if a table is active and filled
     if (m_isTableActive && isWindowModified()) {
         switch (const auto val = createSaveMessageBox(tr("Currently, you are in a Combat. Do you want "
@@ -385,6 +521,12 @@ MainWindow::closeEvent(QCloseEvent *event)
             break;
         }
     }
+
+    // Regular exit, so nothing needs to be restored on the next start
+    if (event->isAccepted()) {
+        m_autosaveTimer->stop();
+        m_tableJournal->clear();
+    }
 }
 
 
@@ -403,14 +545,16 @@ void
 MainWindow::setMainWindowIcons()
 {
     const auto isSystemInDarkMode = Utils::General::isSystemInDarkMode();
+    auto& iconCache = IconCache::instance();
 
-    m_newCombatAction->setIcon(QIcon(isSystemInDarkMode ? ":/icons/menus/new_white.svg" : ":/icons/menus/new_black.svg"));
-    m_openCombatAction->setIcon(QIcon(isSystemInDarkMode ? ":/icons/menus/open_white.svg" : ":/icons/menus/open_black.svg"));
-    m_saveAction->setIcon(QIcon(isSystemInDarkMode ? ":/icons/menus/save_white.svg" : ":/icons/menus/save_black.svg"));
-    m_saveAsAction->setIcon(QIcon(isSystemInDarkMode ? ":/icons/menus/save_as_white.svg" : ":/icons/menus/save_as_black.svg"));
-    m_openSettingsAction->setIcon(QIcon(isSystemInDarkMode ? ":/icons/menus/gear_white.svg" : ":/icons/menus/gear_black.svg"));
-    m_aboutLCMAction->setIcon(QIcon(isSystemInDarkMode ? ":/icons/logos/main_light.svg" : ":/icons/logos/main_dark.svg"));
+    m_newCombatAction->setIcon(iconCache.getIcon(isSystemInDarkMode ? ":/icons/menus/new_white.svg" : ":/icons/menus/new_black.svg"));
+    m_openCombatAction->setIcon(iconCache.getIcon(isSystemInDarkMode ? ":/icons/menus/open_white.svg" : ":/icons/menus/open_black.svg"));
+    m_saveAction->setIcon(iconCache.getIcon(isSystemInDarkMode ? ":/icons/menus/save_white.svg" : ":/icons/menus/save_black.svg"));
+    m_saveAsAction->setIcon(iconCache.getIcon(isSystemInDarkMode ? ":/icons/menus/save_as_white.svg" : ":/icons/menus/save_as_black.svg"));
+    m_openSettingsAction->setIcon(iconCache.getIcon(isSystemInDarkMode ? ":/icons/menus/gear_white.svg" : ":/icons/menus/gear_black.svg"));
+    m_aboutLCMAction->setIcon(iconCache.getIcon(isSystemInDarkMode ? ":/icons/logos/main_light.svg" : ":/icons/logos/main_dark.svg"));
 
+    // Not cached, the taskbar might need sizes far beyond the cached ones
     QApplication::setWindowIcon(QIcon(isSystemInDarkMode ? ":/icons/logos/main_light.svg" : ":/icons/logos/main_dark.svg"));
 }
 
@@ -418,6 +562,10 @@ MainWindow::setMainWindowIcons()
 bool
 MainWindow::event(QEvent *event)
 {
+    // Measured widths depend on the application font
+    if (event->type() == QEvent::ApplicationFontChange) {
+        StringWidthCache::instance().invalidate();
+    }
     if (event->type() == QEvent::ApplicationPaletteChange || event->type() == QEvent::PaletteChange) {
         setMainWindowIcons();
 
@@ -3,12 +3,15 @@
 #include "AdditionalSettings.hpp"
 #include "DirSettings.hpp"
 #include "TableFileHandler.hpp"
+#include "TableJournal.hpp"
 #include "RuleSettings.hpp"
 
+#include <QFutureWatcher>
 #include <QMainWindow>
 #include <QPointer>
 
 class QAction;
+class QTimer;
 
 class CombatWidget;
 class WelcomeWidget;
@@ -30,8 +33,10 @@ private slots:
     void
     newCombat();
 
+    // Save the table. An asynchronous save returns as soon as the writing has been started,
+    // the result is handled once the worker has finished. A running save is awaited first
     bool
-    saveTable();
+    saveTable(bool saveAsync = false);
 
     void
     saveAs();
@@ -39,6 +44,9 @@ private slots:
     void
     openTable();
 
+    void
+    openTableFile(const QString& fileName);
+
     void
     openSettings();
 
@@ -48,7 +56,13 @@ private slots:
     void
     exitCombat();
 
+    void
+    recoverAutosavedTable();
+
 private:
+    void
+    handleSavedTable(bool success);
+
     void
     setWelcomingWidget();
 
@@ -90,7 +104,12 @@ private:
     QPointer<QAction> m_openSettingsAction;
     QPointer<QAction> m_aboutLCMAction;
 
+    QPointer<QFutureWatcher<bool> > m_saveFutureWatcher;
+
+    QPointer<QTimer> m_autosaveTimer;
+
     std::shared_ptr<TableFileHandler> m_tableFileHandler;
+    std::unique_ptr<TableJournal> m_tableJournal;
 
     AdditionalSettings m_additionalSettings;
     RuleSettings m_ruleSettings;
@@ -100,12 +119,19 @@ private:
 
     QString m_fileName{ "" };
     QString m_fileDir{ "" };
+    // File which is currently written to
+    QString m_savingFileName{ "" };
 
     bool m_isTableActive{ false };
     bool m_isTableSavedInFile{ false };
+    // Restored if the current save fails
+    bool m_isTableSavedInFileBeforeSaving{ false };
+    bool m_changeOccuredWhileSaving{ false };
 
     bool m_loadedTableRollAutomatically;
 
     static constexpr unsigned int START_WIDTH = 860;
     static constexpr unsigned int START_HEIGHT = 240;
+
+    static constexpr int AUTOSAVE_DELAY = 1000;
 };
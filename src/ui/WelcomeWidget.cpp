@@ -3,12 +3,15 @@
 #include "UtilsGeneral.hpp"
 
 #include <QApplication>
+#include <QHeaderView>
 #include <QLabel>
 #include <QSvgWidget>
+#include <QTreeWidget>
 #include <QVBoxLayout>
+#include <QtConcurrent/QtConcurrentMap>
 
-WelcomeWidget::WelcomeWidget(QWidget *parent)
-    : QWidget(parent)
+WelcomeWidget::WelcomeWidget(const QStringList& recentFiles, QWidget *parent)
+    : QWidget(parent), m_recentFiles(recentFiles)
 {
     m_svgWidget = new QSvgWidget;
     setSvgWidgetIcon();
@@ -17,6 +20,21 @@ WelcomeWidget::WelcomeWidget(QWidget *parent)
                                              "or open an already existing Combat ('File' -> 'Open...')."));
     welcomeLabel->setAlignment(Qt::AlignCenter);
 
+    // Only the file names are known at first, the Combat stats are filled in once they have been read
+    m_recentFilesWidget = new QTreeWidget;
+    m_recentFilesWidget->setColumnCount(4);
+    m_recentFilesWidget->setHeaderLabels({ tr("Recent Combats"), tr("Round"), tr("Ruleset"), tr("Characters") });
+    m_recentFilesWidget->setRootIsDecorated(false);
+    m_recentFilesWidget->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_recentFilesWidget->setVisible(!m_recentFiles.isEmpty());
+    for (const auto& recentFile : m_recentFiles) {
+        auto *const item = new QTreeWidgetItem(m_recentFilesWidget, { Utils::General::getLCMName(recentFile), "...", "...", "..." });
+        item->setToolTip(0, recentFile);
+    }
+    connect(m_recentFilesWidget, &QTreeWidget::itemDoubleClicked, this, [this] (QTreeWidgetItem *item) {
+        emit recentFileSelected(item->toolTip(0));
+    });
+
     auto* const versionLabel = new QLabel("v2.2.1");
     versionLabel->setToolTip(tr("Minor bugfixes and refactoring."));
     versionLabel->setAlignment(Qt::AlignRight);
@@ -24,9 +42,51 @@ WelcomeWidget::WelcomeWidget(QWidget *parent)
     auto *const layout = new QVBoxLayout(this);
     layout->addWidget(m_svgWidget);
     layout->addWidget(welcomeLabel);
+    layout->addWidget(m_recentFilesWidget);
     layout->addWidget(versionLabel);
     layout->setAlignment(m_svgWidget, Qt::AlignHCenter);
     setLayout(layout);
+
+    m_headerFutureWatcher = new QFutureWatcher<TableFileHandler::TableHeader>(this);
+    connect(m_headerFutureWatcher, &QFutureWatcher<TableFileHandler::TableHeader>::resultReadyAt,
+            this, &WelcomeWidget::setRecentFileHeader);
+    m_headerFutureWatcher->setFuture(QtConcurrent::mapped(m_recentFiles, &TableFileHandler::readTableHeader));
+}
+
+
+WelcomeWidget::~WelcomeWidget()
+{
+    // Do not keep reading files for a widget which is gone
+    m_headerFutureWatcher->cancel();
+    m_headerFutureWatcher->waitForFinished();
+}
+
+
+void
+WelcomeWidget::setRecentFileHeader(int index)
+{
+    const auto tableHeader = m_headerFutureWatcher->resultAt(index);
+    auto *const item = m_recentFilesWidget->topLevelItem(index);
+
+    switch (tableHeader.status) {
+    case 0:
+        item->setText(1, QString::number(tableHeader.roundCounter));
+        item->setText(2, Utils::General::getRulesetName(tableHeader.ruleset));
+        item->setText(3, QString::number(tableHeader.characterCount));
+        break;
+    case 1:
+        item->setText(1, "-");
+        item->setText(2, tr("Wrong Table format!"));
+        item->setText(3, "-");
+        item->setDisabled(true);
+        break;
+    case 2:
+        item->setText(1, "-");
+        item->setText(2, tr("File not found!"));
+        item->setText(3, "-");
+        item->setDisabled(true);
+        break;
+    }
 }
 
 
@@ -1,15 +1,32 @@
 #pragma once
 
+#include "TableFileHandler.hpp"
+
+#include <QFutureWatcher>
 #include <QPointer>
 #include <QWidget>
 
 class QSvgWidget;
+class QTreeWidget;
 
-// This class creates the welcome text
+// This class creates the welcome text and the recently opened Combats
 class WelcomeWidget : public QWidget {
+    Q_OBJECT
+
 public:
     explicit
-    WelcomeWidget(QWidget *parent = 0);
+    WelcomeWidget(const QStringList& recentFiles,
+                  QWidget *          parent = 0);
+
+    ~WelcomeWidget();
+
+signals:
+    void
+    recentFileSelected(const QString& fileName);
+
+private slots:
+    void
+    setRecentFileHeader(int index);
 
 private:
     void
@@ -20,4 +37,10 @@ private:
 
 private:
     QPointer<QSvgWidget> m_svgWidget;
+    QPointer<QTreeWidget> m_recentFilesWidget;
+
+    // Reads the combat stats of the recent files in the background
+    QPointer<QFutureWatcher<TableFileHandler::TableHeader> > m_headerFutureWatcher;
+
+    QStringList m_recentFiles;
 };
@@ -1,6 +1,6 @@
 #include "AdditionalSettings.hpp"
 
-#include <QSettings>
+#include "SettingsStore.hpp"
 
 AdditionalSettings::AdditionalSettings()
 {
@@ -13,39 +13,29 @@ AdditionalSettings::write(bool newIndicatorMultipleChars,
                           bool newRollIniMultipleChars,
                           bool newModAddedToIni)
 {
-    QSettings settings;
+    auto& settingsStore = SettingsStore::instance();
 
-    settings.beginGroup("AdditionalSettings");
     if (indicatorMultipleChars != newIndicatorMultipleChars) {
         indicatorMultipleChars = newIndicatorMultipleChars;
-        settings.setValue("indicatorMultipleChars", indicatorMultipleChars);
+        settingsStore.setValue("AdditionalSettings/indicatorMultipleChars", indicatorMultipleChars);
     }
     if (rollIniMultipleChars != newRollIniMultipleChars) {
         rollIniMultipleChars = newRollIniMultipleChars;
-        settings.setValue("rollIniMultipleChars", rollIniMultipleChars);
+        settingsStore.setValue("AdditionalSettings/rollIniMultipleChars", rollIniMultipleChars);
     }
     if (modAddedToIni != newModAddedToIni) {
         modAddedToIni = newModAddedToIni;
-        settings.setValue("modAddedToIni", modAddedToIni);
+        settingsStore.setValue("AdditionalSettings/modAddedToIni", modAddedToIni);
     }
-    settings.endGroup();
 }
 
 
 void
 AdditionalSettings::read()
 {
-    QSettings settings;
-
-    settings.beginGroup("AdditionalSettings");
-    indicatorMultipleChars = settings.value("indicatorMultipleChars").isValid() ?
-                             settings.value("indicatorMultipleChars").toBool() :
-                             true;
-    rollIniMultipleChars = settings.value("rollIniMultipleChars").isValid() ?
-                           settings.value("rollIniMultipleChars").toBool() :
-                           false;
-    modAddedToIni = settings.value("modAddedToIni").isValid() ?
-                    settings.value("modAddedToIni").toBool() :
-                    true;
-    settings.endGroup();
+    const auto& settingsStore = SettingsStore::instance();
+
+    indicatorMultipleChars = settingsStore.value("AdditionalSettings/indicatorMultipleChars", true).toBool();
+    rollIniMultipleChars = settingsStore.value("AdditionalSettings/rollIniMultipleChars", false).toBool();
+    modAddedToIni = settingsStore.value("AdditionalSettings/modAddedToIni", true).toBool();
 }
@@ -1,7 +1,8 @@
 #include "DirSettings.hpp"
 
+#include "SettingsStore.hpp"
+
 #include <QDir>
-#include <QSettings>
 
 DirSettings::DirSettings()
 {
@@ -15,22 +16,36 @@ DirSettings::write(const QString& fileName, bool setSaveDir)
 {
     openDir = fileName;
 
-    QSettings settings;
-    settings.setValue("dir_open", fileName);
+    auto& settingsStore = SettingsStore::instance();
+    settingsStore.setValue("dir_open", fileName);
 
     if (setSaveDir) {
-        settings.setValue("dir_save", fileName);
+        settingsStore.setValue("dir_save", fileName);
         saveDir = fileName;
     }
 }
 
 
+void
+DirSettings::addRecentFile(const QString& fileName)
+{
+    recentFiles.removeAll(fileName);
+    recentFiles.prepend(fileName);
+    while (recentFiles.size() > MAX_RECENT_FILES) {
+        recentFiles.removeLast();
+    }
+
+    SettingsStore::instance().setValue("recent_files", recentFiles);
+}
+
+
 void
 DirSettings::read()
 {
-    QSettings settings;
-    saveDir = settings.value("dir_save").isValid() ? settings.value("dir_save").toString() : QString();
-    openDir = settings.value("dir_open").isValid() ? settings.value("dir_open").toString() : QString();
+    const auto& settingsStore = SettingsStore::instance();
+    saveDir = settingsStore.value("dir_save").toString();
+    openDir = settingsStore.value("dir_open").toString();
+    recentFiles = settingsStore.value("recent_files").toStringList();
 }
 
 
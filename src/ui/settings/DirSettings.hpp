@@ -3,6 +3,7 @@
 #include "BaseSettings.hpp"
 
 #include <QString>
+#include <QStringList>
 
 // Store data used for handling the opening and saving directories
 class DirSettings : public BaseSettings {
@@ -13,14 +14,23 @@ public:
     write(const QString& fileName,
           bool           setSaveDir = false);
 
+    // Move a table file to the front of the recently used files
+    void
+    addRecentFile(const QString& fileName);
+
 public:
     QString openDir;
     QString saveDir;
 
+    QStringList recentFiles;
+
 private:
     void
     read() override;
 
     void
     handleSubDir();
+
+private:
+    static constexpr int MAX_RECENT_FILES = 100;
 };
@@ -1,6 +1,6 @@
 #include "RuleSettings.hpp"
 
-#include <QSettings>
+#include "SettingsStore.hpp"
 
 RuleSettings::RuleSettings()
 {
@@ -11,31 +11,24 @@ RuleSettings::RuleSettings()
 void
 RuleSettings::write(unsigned int newRuleset, bool newRollAutomatical)
 {
-    QSettings settings;
+    auto& settingsStore = SettingsStore::instance();
 
-    settings.beginGroup("RuleSettings");
     if (ruleset != (int) newRuleset) {
         ruleset = static_cast<Ruleset>(newRuleset);
-        settings.setValue("ruleset", ruleset);
+        settingsStore.setValue("RuleSettings/ruleset", ruleset);
     }
     if (rollAutomatical != newRollAutomatical) {
         rollAutomatical = newRollAutomatical;
-        settings.setValue("roll_auto", rollAutomatical);
+        settingsStore.setValue("RuleSettings/roll_auto", rollAutomatical);
     }
-    settings.endGroup();
 }
 
 
 void
 RuleSettings::read()
 {
-    QSettings settings;
-
-    settings.beginGroup("RuleSettings");
-    ruleset = settings.value("ruleset").isValid() ?
-              static_cast<Ruleset>(settings.value("ruleset").toInt()) :
-              Ruleset::PATHFINDER_1E_DND_35E;
-    rollAutomatical = settings.value("roll_auto").isValid() ?
-                      settings.value("roll_auto").toBool() : false;
-    settings.endGroup();
+    const auto& settingsStore = SettingsStore::instance();
+
+    ruleset = static_cast<Ruleset>(settingsStore.value("RuleSettings/ruleset", Ruleset::PATHFINDER_1E_DND_35E).toInt());
+    rollAutomatical = settingsStore.value("RuleSettings/roll_auto", false).toBool();
 }
@@ -0,0 +1,81 @@
+#include "SettingsStore.hpp"
+
+#include <QCoreApplication>
+#include <QSettings>
+
+#include <utility>
+
+SettingsStore&
+SettingsStore::instance()
+{
+    static SettingsStore settingsStore;
+    return settingsStore;
+}
+
+
+SettingsStore::SettingsStore()
+{
+    const QSettings settings;
+    for (const auto& key : settings.allKeys()) {
+        m_values.insert(key, settings.value(key));
+    }
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(FLUSH_INTERVAL);
+    connect(&m_flushTimer, &QTimer::timeout, this, &SettingsStore::flush);
+    // Do not lose changes made shortly before closing
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &SettingsStore::flush);
+}
+
+
+QVariant
+SettingsStore::value(const QString& key, const QVariant& defaultValue) const
+{
+    return m_values.value(key, defaultValue);
+}
+
+
+void
+SettingsStore::setValue(const QString& key, const QVariant& value)
+{
+    if (const auto it = m_values.constFind(key); it != m_values.constEnd() && *it == value) {
+        return;
+    }
+
+    m_values.insert(key, value);
+    m_changedKeys.insert(key);
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+
+    emit valueChanged(key, value);
+}
+
+
+void
+SettingsStore::flush()
+{
+    m_flushTimer.stop();
+    if (m_changedKeys.empty()) {
+        return;
+    }
+
+    QSettings settings;
+    for (const auto& key : std::as_const(m_changedKeys)) {
+        settings.setValue(key, m_values.value(key));
+    }
+    settings.sync();
+    m_changedKeys.clear();
+}
+
+
+void
+SettingsStore::clear()
+{
+    m_flushTimer.stop();
+    m_values.clear();
+    m_changedKeys.clear();
+
+    QSettings settings;
+    settings.clear();
+}
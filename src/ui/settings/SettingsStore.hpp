@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <QVariant>
+
+// Loads all settings once and serves them from memory. Changed values are collected
+// and written to disk in a single batch after a short delay or when the application quits.
+class SettingsStore : public QObject {
+    Q_OBJECT
+
+public:
+    [[nodiscard]] static SettingsStore&
+    instance();
+
+    [[nodiscard]] QVariant
+    value(const QString&  key,
+          const QVariant& defaultValue = QVariant()) const;
+
+    void
+    setValue(const QString&  key,
+             const QVariant& value);
+
+    // Write all changed values to disk
+    void
+    flush();
+
+    // Remove all values, including the stored ones
+    void
+    clear();
+
+    [[nodiscard]] bool
+    hasPendingChanges() const
+    {
+        return !m_changedKeys.empty();
+    }
+
+signals:
+    void
+    valueChanged(const QString&  key,
+                 const QVariant& value);
+
+private:
+    SettingsStore();
+
+private:
+    QHash<QString, QVariant> m_values;
+    QSet<QString> m_changedKeys;
+
+    QTimer m_flushTimer;
+
+    static constexpr int FLUSH_INTERVAL = 1000;
+};
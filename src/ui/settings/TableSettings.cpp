@@ -1,6 +1,6 @@
 #include "TableSettings.hpp"
 
-#include <QSettings>
+#include "SettingsStore.hpp"
 
 TableSettings::TableSettings()
 {
@@ -11,42 +11,50 @@ TableSettings::TableSettings()
 void
 TableSettings::write(ValueType valueType, bool valueToWrite)
 {
-    QSettings settings;
-
-    settings.beginGroup("TableSettings");
     switch (valueType) {
     case ValueType::INI_SHOWN:
         iniShown = valueToWrite;
-        settings.setValue("INI", iniShown);
         break;
     case ValueType::MOD_SHOWN:
         modifierShown = valueToWrite;
-        settings.setValue("Modifier", modifierShown);
         break;
     case ValueType::COLOR_TABLE:
         colorTableRows = valueToWrite;
-        settings.setValue("ColorTable", colorTableRows);
         break;
     case ValueType::SHOW_INI_TOOLTIPS:
         showIniToolTips = valueToWrite;
-        settings.setValue("IniToolTips", showIniToolTips);
     default:
         break;
     }
 
-    settings.endGroup();
+    SettingsStore::instance().setValue(getKey(valueType), valueToWrite);
+}
+
+
+QString
+TableSettings::getKey(ValueType valueType)
+{
+    switch (valueType) {
+    case ValueType::INI_SHOWN:
+        return "TableSettings/INI";
+    case ValueType::MOD_SHOWN:
+        return "TableSettings/Modifier";
+    case ValueType::COLOR_TABLE:
+        return "TableSettings/ColorTable";
+    case ValueType::SHOW_INI_TOOLTIPS:
+    default:
+        return "TableSettings/IniToolTips";
+    }
 }
 
 
 void
 TableSettings::read()
 {
-    QSettings settings;
-
-    settings.beginGroup("TableSettings");
-    iniShown = settings.value("INI").isValid() ? settings.value("INI").toBool() : true;
-    modifierShown = settings.value("Modifier").isValid() ? settings.value("Modifier").toBool() : true;
-    colorTableRows = settings.value("ColorTable").isValid() ? settings.value("ColorTable").toBool() : false;
-    showIniToolTips = settings.value("IniToolTips").isValid() ? settings.value("IniToolTips").toBool() : false;
-    settings.endGroup();
+    const auto& settingsStore = SettingsStore::instance();
+
+    iniShown = settingsStore.value(getKey(ValueType::INI_SHOWN), true).toBool();
+    modifierShown = settingsStore.value(getKey(ValueType::MOD_SHOWN), true).toBool();
+    colorTableRows = settingsStore.value(getKey(ValueType::COLOR_TABLE), false).toBool();
+    showIniToolTips = settingsStore.value(getKey(ValueType::SHOW_INI_TOOLTIPS), false).toBool();
 }
@@ -2,6 +2,8 @@
 
 #include "BaseSettings.hpp"
 
+#include <QString>
+
 // Store settings used for customizing the table
 class TableSettings : public BaseSettings {
 public:
@@ -18,6 +20,10 @@ public:
     write(ValueType valueType,
           bool      valueToWrite);
 
+    // Key under which the value is stored
+    [[nodiscard]] static QString
+    getKey(ValueType valueType);
+
 public:
     bool iniShown{ true };
     bool modifierShown{ true };
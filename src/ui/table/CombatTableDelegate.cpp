@@ -0,0 +1,47 @@
+#include "CombatTableDelegate.hpp"
+
+#include "CombatTableWidget.hpp"
+#include "UtilsTable.hpp"
+
+#include <QHelpEvent>
+#include <QToolTip>
+
+CombatTableDelegate::CombatTableDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+
+bool
+CombatTableDelegate::helpEvent(QHelpEvent* event, QAbstractItemView* view, const QStyleOptionViewItem& option, const QModelIndex& index)
+{
+    if (event->type() == QEvent::ToolTip && index.column() == Utils::Table::COL_INI) {
+        if (const auto* const tableWidget = qobject_cast<const CombatTableWidget *>(view); tableWidget) {
+            if (const auto toolTip = tableWidget->getIniToolTip(index.row()); !toolTip.isEmpty()) {
+                QToolTip::showText(event->globalPos(), toolTip, view);
+                return true;
+            }
+        }
+    }
+    return QStyledItemDelegate::helpEvent(event, view, option, index);
+}
+
+
+void
+CombatTableDelegate::initStyleOption(QStyleOptionViewItem* option, const QModelIndex& index) const
+{
+    QStyledItemDelegate::initStyleOption(option, index);
+
+    // Also called for the cell widget column, so the color is visible behind the transparent widget
+    if (const auto* const tableWidget = qobject_cast<const CombatTableWidget *>(option->widget); tableWidget) {
+        if (const auto rowColor = tableWidget->getRowColor(index.row()); rowColor.isValid()) {
+            option->backgroundBrush = rowColor;
+        }
+        // Only shown, so the stored name stays the same
+        if (index.column() == Utils::Table::COL_NAME) {
+            if (const auto instanceCount = tableWidget->getInstanceCount(index.row()); instanceCount > 1) {
+                option->text += " (x" + QString::number(instanceCount) + ")";
+            }
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QStyledItemDelegate>
+
+// Delegate for all combat table cells. The row background is painted
+// from the enemy state of the row instead of being stored in every item,
+// the initiative tooltip is only created when it is requested.
+class CombatTableDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit
+    CombatTableDelegate(QObject *parent = nullptr);
+
+    bool
+    helpEvent(QHelpEvent*                 event,
+              QAbstractItemView*          view,
+              const QStyleOptionViewItem& option,
+              const QModelIndex&          index) override;
+
+protected:
+    void
+    initStyleOption(QStyleOptionViewItem* option,
+                    const QModelIndex&    index) const override;
+};
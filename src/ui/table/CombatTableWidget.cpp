@@ -2,10 +2,10 @@
 
 #include "AdditionalInfoData.hpp"
 #include "AdditionalInfoWidget.hpp"
+#include "CombatTableDelegate.hpp"
 #include "UtilsGeneral.hpp"
 #include "UtilsTable.hpp"
 
-#include <QApplication>
 #include <QHeaderView>
 #include <QKeyEvent>
 #include <QLabel>
@@ -41,7 +41,30 @@ CombatTableWidget::CombatTableWidget(std::shared_ptr<CharacterHandler> character
     setColumnWidth(Utils::Table::COL_HP, mainWidgetWidth * WIDTH_HP);
     setColumnWidth(Utils::Table::COL_ENEMY, mainWidgetWidth * WIDTH_ENEMY);
 
-    connect(this, &QTableWidget::itemSelectionChanged, this, &CombatTableWidget::adjustAdditionalInfoWidgetPalette);
+    // The row colors are painted by the delegate, so selection changes only repaint the affected rows
+    setItemDelegate(new CombatTableDelegate(this));
+
+    // Changing the enemy state recolors the whole row
+    connect(model(), &QAbstractItemModel::dataChanged, this, [this] (const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+        if (!m_rowsUncolored && topLeft.column() <= Utils::Table::COL_ENEMY && bottomRight.column() >= Utils::Table::COL_ENEMY) {
+            updateRows(topLeft.row(), bottomRight.row());
+        }
+    });
+
+    // Keep the fingerprints in line with the rows. The model signals are also sent if the table's signals are blocked
+    connect(model(), &QAbstractItemModel::dataChanged, this, [this] (const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+        for (auto row = topLeft.row(); row <= bottomRight.row(); row++) {
+            invalidateRowFingerprint(row);
+        }
+    });
+    connect(model(), &QAbstractItemModel::rowsInserted, this, [this] (const QModelIndex&, int first, int last) {
+        insertRowFingerprints(first, last - first + 1);
+    });
+    connect(model(), &QAbstractItemModel::rowsRemoved, this, [this] (const QModelIndex&, int first, int last) {
+        removeRowFingerprints(first, last - first + 1);
+    });
+    connect(model(), &QAbstractItemModel::modelReset, this, &CombatTableWidget::resetRowFingerprints);
+    connect(model(), &QAbstractItemModel::layoutChanged, this, &CombatTableWidget::resetRowFingerprints);
 }
 
 
@@ -50,15 +73,10 @@ CombatTableWidget::resynchronizeCharacters()
 {
     m_characterHandler->clearCharacters();
 
+    auto& characters = m_characterHandler->getCharacters();
+    characters.reserve(rowCount());
     for (auto i = 0; i < rowCount(); i++) {
-        auto *const additionalInfoWidget = cellWidget(i, 5)->findChild<AdditionalInfoWidget *>();
-
-        m_characterHandler->storeCharacter(item(i, Utils::Table::COL_NAME)->text(),
-                                           item(i, Utils::Table::COL_INI)->text().toInt(),
-                                           item(i, Utils::Table::COL_MODIFIER)->text().toInt(),
-                                           item(i, Utils::Table::COL_HP)->text().toInt(),
-                                           item(i, Utils::Table::COL_ENEMY)->checkState() == Qt::Checked,
-                                           additionalInfoWidget->getAdditionalInformation());
+        characters.push_back(getCharacterFromRow(i));
     }
 }
 
@@ -101,50 +119,37 @@ CombatTableWidget::setRowAndPlayer(QLabel *roundCounterLabel, QLabel *currentPla
 void
 CombatTableWidget::setTableRowColor(bool resetColor)
 {
-    blockSignals(true);
-
+    if (m_rowsUncolored == resetColor) {
+        return;
+    }
     m_rowsUncolored = resetColor;
-    const auto color = [this](bool isEnemy) {
-        if (m_rowsUncolored) {
-            return QApplication::palette().color(QPalette::Base);
-        }
-        return isEnemy ? QColor(255, 194, 10, 60) : QColor(12, 123, 220, 60);
-    };
-
-    for (auto i = 0; i < rowCount(); i++) {
-        const auto cellColor = color(item(i, Utils::Table::COL_ENEMY)->checkState() == Qt::Checked);
+    viewport()->update();
+}
 
-        for (auto j = 0; j < FIRST_FIVE_COLUMNS; j++) {
-            item(i, j)->setBackground(cellColor);
-        }
 
-        QPalette palette;
-        palette.setColor(QPalette::Base, cellColor);
-        palette.setColor(QPalette::Text, palette.color(QPalette::Text));
-        cellWidget(i, Utils::Table::COL_ADDITIONAL)->setAutoFillBackground(!m_rowsUncolored);
-        cellWidget(i, Utils::Table::COL_ADDITIONAL)->setPalette(palette);
+QColor
+CombatTableWidget::getRowColor(int row) const
+{
+    if (m_rowsUncolored) {
+        return QColor();
     }
 
-    blockSignals(false);
+    const auto* const enemyItem = item(row, Utils::Table::COL_ENEMY);
+    return enemyItem && enemyItem->checkState() == Qt::Checked ? QColor(255, 194, 10, 60) : QColor(12, 123, 220, 60);
 }
 
 
-void
-CombatTableWidget::setIniColumnTooltips(bool resetToolTip)
+QString
+CombatTableWidget::getIniToolTip(int row) const
 {
-    blockSignals(true);
-
-    for (auto i = 0; i < rowCount(); i++) {
-        auto toolTipString = QString();
-        if (!resetToolTip) {
-            const auto rolledValue = item(i, 1)->text().toInt() - item(i, 2)->text().toInt();
-            toolTipString += "Calculation: Rolled Value " + QString::number(rolledValue) + ", Modifier " + item(i, 2)->text();
-        }
-
-        item(i, 1)->setToolTip(toolTipString);
+    const auto* const iniItem = item(row, Utils::Table::COL_INI);
+    const auto* const modifierItem = item(row, Utils::Table::COL_MODIFIER);
+    if (!m_iniToolTipsShown || !iniItem || !modifierItem) {
+        return QString();
     }
 
-    blockSignals(false);
+    const auto rolledValue = iniItem->text().toInt() - modifierItem->text().toInt();
+    return "Calculation: Rolled Value " + QString::number(rolledValue) + ", Modifier " + modifierItem->text();
 }
 
 
@@ -153,6 +158,7 @@ CombatTableWidget::setStatusEffectInWidget(QVector<AdditionalInfoData::StatusEff
 {
     auto* const additionalInfoWidget = cellWidget(row, Utils::Table::COL_ADDITIONAL)->findChild<AdditionalInfoWidget *>();
     additionalInfoWidget->setStatusEffects(statusEffects);
+    invalidateRowFingerprint(row);
 }
 
 
@@ -162,50 +168,107 @@ CombatTableWidget::adjustStatusEffectRoundCounter(bool decrease)
     for (auto i = 0; i < rowCount(); i++) {
         auto* const additionalInfoWidget = cellWidget(i, Utils::Table::COL_ADDITIONAL)->findChild<AdditionalInfoWidget *>();
         additionalInfoWidget->adjustEffectDuration(decrease);
+        invalidateRowFingerprint(i);
     }
 }
 
 
-QVector<QVector<QVariant> >
-CombatTableWidget::tableDataFromWidget()
+void
+CombatTableWidget::setHpItem(int row, const CharacterHandler::Character& character)
 {
-    QVector<QVector<QVariant> > tableData;
-    for (auto i = 0; i < rowCount(); i++) {
-        QVector<QVariant> rowValues;
+    auto* hpItem = item(row, Utils::Table::COL_HP);
+    if (!hpItem) {
+        hpItem = new QTableWidgetItem;
+        setItem(row, Utils::Table::COL_HP, hpItem);
+    }
+    hpItem->setText(QString::number(character.hp));
 
-        for (auto j = 0; j < FIRST_FOUR_COLUMNS; j++) {
-            rowValues.push_back(item(i, j)->text());
-        }
+    if (!character.isGroup()) {
+        hpItem->setData(Qt::UserRole, QVariant());
+        hpItem->setToolTip(QString());
+        hpItem->setFlags(hpItem->flags() | Qt::ItemIsEditable);
+        return;
+    }
 
-        rowValues.push_back(item(i, Utils::Table::COL_ENEMY)->checkState() == Qt::Checked);
+    QStringList instanceHpTexts;
+    for (const auto value : character.instanceHp) {
+        instanceHpTexts << QString::number(value);
+    }
+    hpItem->setData(Qt::UserRole, QVariant::fromValue(character.instanceHp));
+    hpItem->setToolTip(tr("HP of the single Characters: ") + instanceHpTexts.join(", "));
+    // The total is calculated from the instances
+    hpItem->setFlags(hpItem->flags() & ~Qt::ItemIsEditable);
+}
+
+
+int
+CombatTableWidget::getInstanceCount(int row) const
+{
+    const auto* const hpItem = item(row, Utils::Table::COL_HP);
+    return hpItem ? std::max<int>(hpItem->data(Qt::UserRole).value<QVector<int> >().size(), 1) : 1;
+}
 
-        QVariant variant;
-        variant.setValue(cellWidget(i, Utils::Table::COL_ADDITIONAL)->findChild<AdditionalInfoWidget *>()->getAdditionalInformation());
-        rowValues.push_back(variant);
 
-        tableData.push_back(rowValues);
+QVector<CharacterHandler::Character>
+CombatTableWidget::tableDataFromWidget()
+{
+    QVector<CharacterHandler::Character> tableData;
+    tableData.reserve(rowCount());
+    for (auto i = 0; i < rowCount(); i++) {
+        tableData.push_back(getCharacterFromRow(i));
     }
 
     return tableData;
 }
 
 
-QVector<QVector<QVariant> >
+QVector<CharacterHandler::Character>
 CombatTableWidget::tableDataFromCharacterVector()
 {
-    QVector<QVector<QVariant> > tableData;
-    for (const auto& character : m_characterHandler->getCharacters()) {
-        QVector<QVariant> charValues;
+    return m_characterHandler->getCharacters();
+}
 
-        QVariant additionalInfoVariant;
-        additionalInfoVariant.setValue(character.additionalInfoData);
-        charValues << character.name << character.initiative << character.modifier
-                   << character.hp << character.isEnemy << additionalInfoVariant;
 
-        tableData.push_back(charValues);
+quint64
+CombatTableWidget::getRowFingerprint(int row)
+{
+    if (!m_isRowFingerprintValid.at(row)) {
+        m_rowFingerprints[row] = getCharacterFromRow(row).getFingerprint();
+        m_isRowFingerprintValid[row] = true;
+        m_tableFingerprint += getTableFingerprintPart(row, m_rowFingerprints.at(row));
     }
+    return m_rowFingerprints.at(row);
+}
 
-    return tableData;
+
+QVector<quint64>
+CombatTableWidget::getRowFingerprints()
+{
+    for (auto i = 0; i < m_rowFingerprints.size(); i++) {
+        static_cast<void>(getRowFingerprint(i));
+    }
+    return m_rowFingerprints;
+}
+
+
+quint64
+CombatTableWidget::getTableFingerprint()
+{
+    for (auto i = 0; i < m_rowFingerprints.size(); i++) {
+        static_cast<void>(getRowFingerprint(i));
+    }
+    return m_tableFingerprint;
+}
+
+
+void
+CombatTableWidget::invalidateRowFingerprint(int row)
+{
+    if (row < 0 || row >= m_rowFingerprints.size() || !m_isRowFingerprintValid.at(row)) {
+        return;
+    }
+    m_tableFingerprint -= getTableFingerprintPart(row, m_rowFingerprints.at(row));
+    m_isRowFingerprintValid[row] = false;
 }
 
 
@@ -232,30 +295,100 @@ CombatTableWidget::keyPressEvent(QKeyEvent *event)
 }
 
 
+bool
+CombatTableWidget::viewportEvent(QEvent *event)
+{
+    const auto result = QTableWidget::viewportEvent(event);
+    if (event->type() == QEvent::Paint) {
+        emit viewportPainted();
+    }
+    return result;
+}
+
+
+bool
+CombatTableWidget::edit(const QModelIndex& index, EditTrigger trigger, QEvent* event)
+{
+    // Every click or key press tries to edit, so only report actually opened editors
+    const auto wasEditing = state() == QAbstractItemView::EditingState;
+    const auto result = QTableWidget::edit(index, trigger, event);
+    if (result && !wasEditing && state() == QAbstractItemView::EditingState) {
+        emit editStarted();
+    }
+    return result;
+}
+
+
 void
-CombatTableWidget::adjustAdditionalInfoWidgetPalette()
+CombatTableWidget::updateRows(int firstRow, int lastRow)
 {
-    // If the table rows are colored and a row is selected, the selection color will mix
-    // with the cell widget color because of the non-maximum alpha values.
-    // So we set the alpha value for selected rows to 0 to circumvent this problem
-    if (m_rowsUncolored) {
-        return;
+    for (auto row = firstRow; row <= lastRow; row++) {
+        viewport()->update(QRect(0, rowViewportPosition(row), viewport()->width(), rowHeight(row)));
     }
-    // Reset all colors because other rows might have been selected before
-    setTableRowColor(m_rowsUncolored);
+}
 
-    const auto selectedRows = selectionModel()->selectedRows();
 
-    for (const auto& selectedModel : selectedRows) {
-        const auto row = selectedModel.row();
+CharacterHandler::Character
+CombatTableWidget::getCharacterFromRow(int row) const
+{
+    auto character = CharacterHandler::Character(item(row, Utils::Table::COL_NAME)->text(), item(row, Utils::Table::COL_INI)->text().toInt(),
+                                                 item(row, Utils::Table::COL_MODIFIER)->text().toInt(), item(row, Utils::Table::COL_HP)->text().toInt(),
+                                                 item(row, Utils::Table::COL_ENEMY)->checkState() == Qt::Checked,
+                                                 cellWidget(row, Utils::Table::COL_ADDITIONAL)->findChild<AdditionalInfoWidget *>()->getAdditionalInformation());
+    if (const auto instanceHp = item(row, Utils::Table::COL_HP)->data(Qt::UserRole).value<QVector<int> >(); !instanceHp.empty()) {
+        character.setInstanceHp(instanceHp);
+    }
+    return character;
+}
 
-        auto palette = cellWidget(row, Utils::Table::COL_ADDITIONAL)->palette();
-        auto baseColor = palette.color(QPalette::Base);
-        auto highlightedTextColor = palette.color(QPalette::HighlightedText);
 
-        baseColor.setAlpha(0);
-        palette.setColor(QPalette::Base, baseColor);
-        palette.setColor(QPalette::Text, highlightedTextColor);
-        cellWidget(row, Utils::Table::COL_ADDITIONAL)->setPalette(palette);
+void
+CombatTableWidget::insertRowFingerprints(int first, int count)
+{
+    // The following rows move, so their parts of the table fingerprint change
+    for (auto i = first; i < m_rowFingerprints.size(); i++) {
+        if (m_isRowFingerprintValid.at(i)) {
+            m_tableFingerprint += getTableFingerprintPart(i + count, m_rowFingerprints.at(i)) -
+                                  getTableFingerprintPart(i, m_rowFingerprints.at(i));
+        }
     }
+    m_rowFingerprints.insert(first, count, 0);
+    m_isRowFingerprintValid.insert(first, count, false);
+}
+
+
+void
+CombatTableWidget::removeRowFingerprints(int first, int count)
+{
+    for (auto i = first; i < m_rowFingerprints.size(); i++) {
+        if (!m_isRowFingerprintValid.at(i)) {
+            continue;
+        }
+        m_tableFingerprint -= getTableFingerprintPart(i, m_rowFingerprints.at(i));
+        if (i >= first + count) {
+            m_tableFingerprint += getTableFingerprintPart(i - count, m_rowFingerprints.at(i));
+        }
+    }
+    m_rowFingerprints.remove(first, count);
+    m_isRowFingerprintValid.remove(first, count);
+}
+
+
+void
+CombatTableWidget::resetRowFingerprints()
+{
+    m_rowFingerprints.fill(0, rowCount());
+    m_isRowFingerprintValid.fill(false, rowCount());
+    m_tableFingerprint = 0;
+}
+
+
+quint64
+CombatTableWidget::getTableFingerprintPart(int row, quint64 rowFingerprint)
+{
+    // Mix in the position, so swapped rows change the table fingerprint
+    auto part = rowFingerprint + (quint64) (row + 1) * 0x9E3779B97F4A7C15ULL;
+    part = (part ^ (part >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    part = (part ^ (part >> 27)) * 0x94D049BB133111EBULL;
+    return part ^ (part >> 31);
 }
@@ -29,8 +29,19 @@ public:
     void
     setTableRowColor(bool resetColor);
 
+    // Background color of a row, invalid if the rows are uncolored
+    [[nodiscard]] QColor
+    getRowColor(int row) const;
+
     void
-    setIniColumnTooltips(bool resetToolTip);
+    setIniColumnTooltips(bool resetToolTip)
+    {
+        m_iniToolTipsShown = !resetToolTip;
+    }
+
+    // Created when the tooltip is requested, empty if the tooltips are disabled
+    [[nodiscard]] QString
+    getIniToolTip(int row) const;
 
     void
     setStatusEffectInWidget(QVector<AdditionalInfoData::StatusEffect> statusEffects,
@@ -39,29 +50,97 @@ public:
     void
     adjustStatusEffectRoundCounter(bool decrease);
 
+    // Groups store the hp of their instances in the item, the shown total can not be edited
+    void
+    setHpItem(int                                row,
+              const CharacterHandler::Character& character);
+
+    // Number of characters a row stands for, 1 if it is not a group
+    [[nodiscard]] int
+    getInstanceCount(int row) const;
+
     // Store the table cell values in a vector
-    [[nodiscard]] QVector<QVector<QVariant> >
+    [[nodiscard]] QVector<CharacterHandler::Character>
     tableDataFromWidget();
 
-    // Reformat the character vector in a QVariant vector
-    [[nodiscard]] QVector<QVector<QVariant> >
+    // The stored characters are implicitly shared, so this does not copy them
+    [[nodiscard]] QVector<CharacterHandler::Character>
     tableDataFromCharacterVector();
 
+    // Fingerprint of a row's content, only recalculated after the row has been changed
+    [[nodiscard]] quint64
+    getRowFingerprint(int row);
+
+    [[nodiscard]] QVector<quint64>
+    getRowFingerprints();
+
+    // Combination of all row fingerprints, updated together with them
+    [[nodiscard]] quint64
+    getTableFingerprint();
+
+    // Cell widget changes are not reported by the model, so they have to be marked manually
+    void
+    invalidateRowFingerprint(int row);
+
     [[nodiscard]] unsigned int
     getHeight() const;
 
+    using QTableWidget::edit;
+
+signals:
+    void
+    viewportPainted();
+
+    // Emitted once an editor has been opened, before the edited cell changes
+    void
+    editStarted();
+
 protected:
     void
     keyPressEvent(QKeyEvent *event) override;
 
+    bool
+    viewportEvent(QEvent *event) override;
+
+    bool
+    edit(const QModelIndex& index,
+         EditTrigger        trigger,
+         QEvent*            event) override;
+
 private:
     void
-    adjustAdditionalInfoWidgetPalette();
+    updateRows(int firstRow,
+               int lastRow);
+
+    [[nodiscard]] CharacterHandler::Character
+    getCharacterFromRow(int row) const;
+
+    void
+    insertRowFingerprints(int first,
+                          int count);
+
+    void
+    removeRowFingerprints(int first,
+                          int count);
+
+    void
+    resetRowFingerprints();
+
+    // Part of a row in the table fingerprint, depending on its position
+    [[nodiscard]] static quint64
+    getTableFingerprintPart(int     row,
+                            quint64 rowFingerprint);
 
 private:
     std::shared_ptr<CharacterHandler> m_characterHandler;
 
-    bool m_rowsUncolored;
+    QVector<quint64> m_rowFingerprints;
+    QVector<bool> m_isRowFingerprintValid;
+    // Sum of the parts of all valid row fingerprints
+    quint64 m_tableFingerprint{ 0 };
+
+    bool m_rowsUncolored{ true };
+    bool m_iniToolTipsShown{ false };
 
     static constexpr int FIRST_FOUR_COLUMNS = 4;
     static constexpr int FIRST_FIVE_COLUMNS = 5;
@@ -1,21 +1,29 @@
 #include "CombatWidget.hpp"
 
 #include "AddCharacterDialog.hpp"
+#include "AdditionalInfoWidget.hpp"
 #include "AdditionalSettings.hpp"
 #include "ChangeHPDialog.hpp"
 #include "DelegateSpinBox.hpp"
+#include "HpUndo.hpp"
+#include "IconCache.hpp"
 #include "RuleSettings.hpp"
+#include "SettingsStore.hpp"
 #include "StatusEffectDialog.hpp"
+#include "StringWidthCache.hpp"
 #include "Undo.hpp"
 #include "UtilsGeneral.hpp"
 #include "UtilsTable.hpp"
+#include "UtilsTrace.hpp"
 
 #include <QAction>
 #include <QApplication>
 #include <QContextMenuEvent>
 #include <QFileDialog>
+#include <QHash>
 #include <QHBoxLayout>
 #include <QHeaderView>
+#include <QJsonArray>
 #include <QLabel>
 #include <QMenu>
 #include <QMessageBox>
@@ -25,6 +33,10 @@
 #include <QToolButton>
 #include <QUndoStack>
 #include <QVBoxLayout>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <numeric>
 
 CombatWidget::CombatWidget(std::shared_ptr<TableFileHandler> tableFilerHandler,
                            const AdditionalSettings&         AdditionalSettings,
@@ -42,6 +54,9 @@ CombatWidget::CombatWidget(std::shared_ptr<TableFileHandler> tableFilerHandler,
 
     m_undoStack = new QUndoStack(this);
 
+    m_layoutScheduler = new LayoutScheduler(this);
+    m_latencyMonitor = new LatencyMonitor(this);
+
     m_addCharacterAction = createAction(tr("Add new Character(s)..."), tr("Add new Character(s)"),
                                         QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_N), true);
     m_insertTableAction = createAction(tr("Insert other Table..."), tr("Insert another table without overwriting the current one"),
@@ -49,16 +64,22 @@ CombatWidget::CombatWidget(std::shared_ptr<TableFileHandler> tableFilerHandler,
     m_removeAction = createAction(tr("Remove"), tr("Remove Character(s)"), QKeySequence(Qt::Key_Delete), false);
     m_addEffectAction = createAction(tr("Add Status Effect(s)..."), tr("Add Status Effect(s)"), QKeySequence(Qt::CTRL | Qt::Key_E), false);
     m_duplicateAction = createAction(tr("Duplicate"), tr("Duplicate Character"), QKeySequence(Qt::CTRL | Qt::Key_D), false);
+    m_expandGroupAction = createAction(tr("Expand Group"), tr("Replace the Group by single Characters"), QKeySequence(), false);
     m_rerollAction = createAction(tr("Reroll Initiative"), tr("Reroll Initiative"), QKeySequence(Qt::CTRL | Qt::Key_I), false);
     m_changeHPAction = createAction(tr("Change HP"), tr("Change HP for multiple Characters at once"), QKeySequence(Qt::CTRL | Qt::Key_H), false);
     m_resortAction = createAction(tr("Resort Table"), "", QKeySequence(Qt::CTRL | Qt::Key_R), true);
     m_moveUpwardAction = createAction(tr("Move Upward"), "", QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_Up), true);
     m_moveDownwardAction = createAction(tr("Move Downward"), "", QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_Down), true);
 
-    m_undoAction = m_undoStack->createUndoAction(this, tr("&Undo"));
+    // Created like the other actions, so an undo or redo is measured from the trigger on
+    m_undoAction = createAction(tr("&Undo"), "", QKeySequence(), m_undoStack->canUndo());
     m_undoAction->setShortcuts(QKeySequence::Undo);
-    m_redoAction = m_undoStack->createRedoAction(this, tr("&Redo"));
+    m_redoAction = createAction(tr("&Redo"), "", QKeySequence(), m_undoStack->canRedo());
     m_redoAction->setShortcuts(QKeySequence::Redo);
+    connect(m_undoAction, &QAction::triggered, m_undoStack, &QUndoStack::undo);
+    connect(m_redoAction, &QAction::triggered, m_undoStack, &QUndoStack::redo);
+    connect(m_undoStack, &QUndoStack::canUndoChanged, m_undoAction, &QAction::setEnabled);
+    connect(m_undoStack, &QUndoStack::canRedoChanged, m_redoAction, &QAction::setEnabled);
 
     addAction(m_resortAction);
     addAction(m_changeHPAction);
@@ -139,6 +160,7 @@ CombatWidget::CombatWidget(std::shared_ptr<TableFileHandler> tableFilerHandler,
     connect(m_removeAction, &QAction::triggered, this, &CombatWidget::removeRow);
     connect(m_addEffectAction, &QAction::triggered, this, &CombatWidget::openStatusEffectDialog);
     connect(m_duplicateAction, &QAction::triggered, this, &CombatWidget::duplicateRow);
+    connect(m_expandGroupAction, &QAction::triggered, this, &CombatWidget::expandGroup);
     connect(m_rerollAction, &QAction::triggered, this, &CombatWidget::rerollIni);
     connect(m_changeHPAction, &QAction::triggered, this, &CombatWidget::changeHPForMultipleChars);
     connect(m_resortAction, &QAction::triggered, this, &CombatWidget::sortTable);
@@ -152,24 +174,28 @@ CombatWidget::CombatWidget(std::shared_ptr<TableFileHandler> tableFilerHandler,
     connect(m_tableWidget->verticalHeader(), &QHeaderView::sectionPressed, this, [this](int logicalIndex) {
         m_tableWidget->clearSelection();
         m_tableWidget->selectRow(logicalIndex);
-        saveOldState();
+        // The old table itself is only needed once a row is actually moved
+        m_headerDataState = m_tableWidget->verticalHeader()->saveState();
     });
     connect(m_tableWidget->verticalHeader(), &QHeaderView::sectionMoved, this, &CombatWidget::dragAndDrop);
     connect(m_tableWidget, &QTableWidget::cellChanged, this, [this] {
         emit changeOccured();
     });
-    connect(m_tableWidget, &QTableWidget::itemPressed, this, [this] {
-        saveOldState();
-    });
     connect(m_tableWidget, &QTableWidget::itemSelectionChanged, this, [this] {
         m_removeAction->setEnabled(m_tableWidget->selectionModel()->hasSelection());
         m_addEffectAction->setEnabled(m_tableWidget->selectionModel()->hasSelection());
         m_duplicateAction->setEnabled(m_tableWidget->selectionModel()->selectedRows().size() == 1);
+        m_expandGroupAction->setEnabled(m_tableWidget->selectionModel()->selectedRows().size() == 1 &&
+                                        m_tableWidget->getInstanceCount(m_tableWidget->currentRow()) > 1);
         m_rerollAction->setEnabled(m_tableWidget->selectionModel()->selectedRows().size() == 1);
-        m_changeHPAction->setEnabled(m_tableWidget->selectionModel()->selectedRows().size() > 1);
+        m_changeHPAction->setEnabled(m_tableWidget->selectionModel()->selectedRows().size() > 1 ||
+                                     (m_tableWidget->selectionModel()->selectedRows().size() == 1 &&
+                                      m_tableWidget->getInstanceCount(m_tableWidget->currentRow()) > 1));
     });
-    connect(m_tableWidget, &QTableWidget::currentCellChanged, this, [this] {
-        saveOldState();
+    // Clicks and cursor moves do not change anything, so the old state is only taken once an edit starts
+    connect(m_tableWidget, &CombatTableWidget::editStarted, this, [this] {
+        m_tableWidget->resynchronizeCharacters();
+        saveOldState(true);
     });
     connect(m_tableWidget, &QTableWidget::itemChanged, this, &CombatWidget::handleTableWidgetItemPressed);
     connect(m_tableWidget->model(), &QAbstractItemModel::rowsInserted, this, [this] {
@@ -180,9 +206,11 @@ CombatWidget::CombatWidget(std::shared_ptr<TableFileHandler> tableFilerHandler,
     });
 
     connect(upButton, &QPushButton::clicked, this, [this] {
+        startAction("Previous");
         enteredRowChanged(false);
     });
     connect(downButton, &QPushButton::clicked, this, [this] {
+        startAction("Next");
         enteredRowChanged(true);
     });
     connect(exitButton, &QPushButton::clicked, this, [this] {
@@ -192,12 +220,38 @@ CombatWidget::CombatWidget(std::shared_ptr<TableFileHandler> tableFilerHandler,
     connect(m_timer, &QTimer::timeout, this, [this] {
         Utils::General::animateLabel(m_iniRerolledLabel);
     });
+
+    connect(m_tableWidget, &CombatTableWidget::viewportPainted, m_latencyMonitor, &LatencyMonitor::finish);
+
+    // Only the changed table option is applied
+    connect(&SettingsStore::instance(), &SettingsStore::valueChanged, this, [this] (const QString& key, const QVariant& value) {
+        for (const auto valueType : { TableSettings::ValueType::INI_SHOWN, TableSettings::ValueType::MOD_SHOWN,
+                                      TableSettings::ValueType::COLOR_TABLE, TableSettings::ValueType::SHOW_INI_TOOLTIPS }) {
+            if (key == TableSettings::getKey(valueType)) {
+                applyTableOption(value.toBool(), valueType);
+            }
+        }
+    });
+
+    connect(m_layoutScheduler, &LayoutScheduler::widthPassRequested, this, [this] {
+        auto mainWidth = 0;
+        for (int i = 0; i < m_tableWidget->columnCount(); i++) {
+            mainWidth += m_tableWidget->columnWidth(i);
+        }
+        // The main window will adjust and the additional info column will be lenghtened
+        emit tableWidthSet(mainWidth + COL_LENGTH_BUFFER_ADDITIONAL);
+    });
+    connect(m_layoutScheduler, &LayoutScheduler::heightPassRequested, this, [this] {
+        emit tableHeightSet(getHeight());
+    });
 }
 
 
 void
 CombatWidget::generateTableFromTableData()
 {
+    TRACE_SCOPE("CombatWidget::generateTableFromTableData");
+
     if (!m_isDataStored) {
         return;
     }
@@ -217,6 +271,7 @@ CombatWidget::generateTableFromTableData()
     }
 
     // Then create the table in the ui
+    m_layoutScheduler->setAction("Load Table");
     pushOnUndoStack();
     // We do not need a save step directly after table creation
     m_undoStack->clear();
@@ -231,11 +286,29 @@ CombatWidget::writeTableToFile(const QString& fileName)
 }
 
 
+QFuture<bool>
+CombatWidget::writeTableToFileAsync(const QString& fileName)
+{
+    // Only the snapshot is created on the UI thread. The copied data is implicitly shared,
+    // so this is cheap and the worker does not access any widgets
+    return QtConcurrent::run([tableFileHandler = m_tableFileHandler, tableData = m_tableWidget->tableDataFromWidget(),
+                              fileName, rowEntered = m_rowEntered, roundCounter = m_roundCounter,
+                              ruleset = m_ruleSettings.ruleset, rollAutomatically = m_ruleSettings.rollAutomatical] {
+        return tableFileHandler->writeToFile(tableData, fileName, rowEntered, roundCounter, ruleset, rollAutomatically);
+    });
+}
+
+
 // Save the old table state before a table change occurs (later used for the undo stack)
 void
-CombatWidget::saveOldState()
+CombatWidget::saveOldState(bool isSynchronized)
 {
-    m_tableDataOld = m_tableWidget->tableDataFromWidget();
+    TRACE_SCOPE("CombatWidget::saveOldState");
+
+    // Synchronized characters match the table, so they are shared instead of reading all rows again
+    m_tableDataOld = isSynchronized ? m_tableWidget->tableDataFromCharacterVector() : m_tableWidget->tableDataFromWidget();
+    m_rowFingerprintsOld = m_tableWidget->getRowFingerprints();
+    m_tableFingerprintOld = m_tableWidget->getTableFingerprint();
     m_rowEnteredOld = m_rowEntered;
     m_roundCounterOld = m_roundCounter;
 
@@ -246,6 +319,8 @@ CombatWidget::saveOldState()
 void
 CombatWidget::pushOnUndoStack(bool resynchronize)
 {
+    TRACE_SCOPE("CombatWidget::pushOnUndoStack");
+
     // Assemble old data
     const auto oldData = Undo::UndoData{ m_tableDataOld, m_rowEnteredOld, m_roundCounterOld };
     if (resynchronize) {
@@ -254,11 +329,77 @@ CombatWidget::pushOnUndoStack(bool resynchronize)
     // Assemble the new data
     const auto tableData = m_tableWidget->tableDataFromCharacterVector();
     const auto newData = Undo::UndoData{ tableData, m_rowEntered, m_roundCounter };
+
+    // Find the changed rows once, so undoing and redoing only has to update these
+    auto changedRows = m_changedRowIndices;
+    if (m_removedOrAddedRowIndices.empty() && changedRows.empty()) {
+        // Resynchronized characters match the table, so the incrementally updated fingerprints are used.
+        // Otherwise the characters have been changed directly and have to be hashed
+        const auto rowFingerprints = resynchronize ? m_tableWidget->getRowFingerprints() : QVector<quint64>();
+        for (auto i = 0; i < std::min(tableData.size(), m_rowFingerprintsOld.size()); i++) {
+            const auto rowFingerprint = resynchronize ? rowFingerprints.at(i) : tableData.at(i).getFingerprint();
+            if (rowFingerprint != m_rowFingerprintsOld.at(i)) {
+                changedRows.push_back(i);
+            }
+        }
+    }
+
     // We got everything, so push
     m_undoStack->push(new Undo(this, m_roundCounterLabel, m_currentPlayerLabel,
-                               oldData, newData, m_removedOrAddedRowIndices, &m_rowEntered, &m_roundCounter,
-                               m_tableSettings.colorTableRows, m_tableSettings.showIniToolTips));
+                               oldData, newData, m_removedOrAddedRowIndices, changedRows, m_movedRowSources, &m_rowEntered,
+                               &m_roundCounter, m_tableSettings.colorTableRows, m_tableSettings.showIniToolTips));
     m_removedOrAddedRowIndices.clear();
+    m_changedRowIndices.clear();
+    m_movedRowSources.clear();
+}
+
+
+void
+CombatWidget::applyHpChanges(const QVector<CharacterHandler::HpChange>& hpChanges, bool isSynchronized)
+{
+    TRACE_SCOPE("CombatWidget::applyHpChanges");
+
+    if (!isSynchronized) {
+        m_tableWidget->resynchronizeCharacters();
+    }
+
+    // Only the hp values of the changed characters are stored for undoing
+    const auto& characters = m_characterHandler->getCharacters();
+    QHash<int, CharacterHandler::Character> oldCharacters;
+    for (const auto& hpChange : hpChanges) {
+        if (hpChange.row >= 0 && hpChange.row < characters.size() && !oldCharacters.contains(hpChange.row)) {
+            oldCharacters.insert(hpChange.row, characters.at(hpChange.row));
+        }
+    }
+
+    const auto changedRows = m_characterHandler->applyHpChanges(hpChanges);
+    if (changedRows.empty()) {
+        return;
+    }
+
+    QVector<HpUndo::HpValue> hpValues;
+    for (const auto row : changedRows) {
+        const auto& oldCharacter = oldCharacters[row];
+        const auto& character = characters.at(row);
+        if (!character.isGroup()) {
+            hpValues.push_back({ row, -1, oldCharacter.hp, character.hp });
+            continue;
+        }
+        for (auto i = 0; i < character.getInstanceCount(); i++) {
+            if (character.instanceHp.at(i) != oldCharacter.instanceHp.at(i)) {
+                hpValues.push_back({ row, i, oldCharacter.instanceHp.at(i), character.instanceHp.at(i) });
+            }
+        }
+    }
+    m_undoStack->push(new HpUndo(this, m_characterHandler, hpValues));
+}
+
+
+void
+CombatWidget::startAction(const QString& action)
+{
+    m_layoutScheduler->setAction(action);
+    m_latencyMonitor->start(action);
 }
 
 
@@ -282,36 +423,67 @@ CombatWidget::resetNameAndInfoWidth(const int nameWidth, const int addInfoWidth)
     }
 
     if (changeOccured) {
-        // Change the main window width
-        auto mainWidth = 0;
-        for (int i = 0; i < m_tableWidget->columnCount(); i++) {
-            mainWidth += m_tableWidget->columnWidth(i);
+        // Change the main window width once all pending column changes are done
+        m_layoutScheduler->markWidthDirty();
+    }
+}
+
+
+QVector<TableJournal::Operation>
+CombatWidget::takeJournalOperations()
+{
+    auto journalOperations = m_journalOperations;
+    m_journalOperations.clear();
+    return journalOperations;
+}
+
+
+void
+CombatWidget::resetNameAndInfoWidths(const std::vector<int>& rows)
+{
+    auto& stringWidthCache = StringWidthCache::instance();
+    auto nameWidth = 0;
+    auto addInfoWidth = 0;
+
+    for (const auto i : rows) {
+        if (i < 0 || i >= m_tableWidget->rowCount()) {
+            continue;
+        }
+        if (const auto* const nameItem = m_tableWidget->item(i, Utils::Table::COL_NAME); nameItem) {
+            nameWidth = std::max(nameWidth, stringWidthCache.getWidth(nameItem->text()));
+        }
+        if (auto* const cellWidget = m_tableWidget->cellWidget(i, Utils::Table::COL_ADDITIONAL); cellWidget) {
+            addInfoWidth = std::max(addInfoWidth, cellWidget->findChild<AdditionalInfoWidget *>()->getWidth());
         }
-        // The main window will adjust and the additional info column will be lenghtened
-        emit tableWidthSet(mainWidth + COL_LENGTH_BUFFER_ADDITIONAL);
     }
+
+    resetNameAndInfoWidth(nameWidth, addInfoWidth);
 }
 
 
 void
 CombatWidget::setUndoRedoIcon(bool isDarkMode)
 {
-    m_addCharacterAction->setIcon(isDarkMode ? QIcon(":/icons/table/add_white.svg") : QIcon(":/icons/table/add_black.svg"));
-    m_insertTableAction->setIcon(isDarkMode ? QIcon(":/icons/table/insert_table_white.svg") : QIcon(":/icons/table/insert_table_black.svg"));
-    m_removeAction->setIcon(isDarkMode ? QIcon(":/icons/table/remove_white.svg") : QIcon(":/icons/table/remove_black.svg"));
-    m_addEffectAction->setIcon(isDarkMode ? QIcon(":/icons/table/effect_white.svg") : QIcon(":/icons/table/effect_black.svg"));
-    m_duplicateAction->setIcon(isDarkMode ? QIcon(":/icons/table/duplicate_white.svg") : QIcon(":/icons/table/duplicate_black.svg"));
-    m_rerollAction->setIcon(isDarkMode ? QIcon(":/icons/table/reroll_white.svg") : QIcon(":/icons/table/reroll_black.svg"));
-    m_changeHPAction->setIcon(isDarkMode ? QIcon(":/icons/table/change_hp_white.svg") : QIcon(":/icons/table/change_hp_black.svg"));
-    m_resortAction->setIcon(isDarkMode ? QIcon(":/icons/table/sort_white.svg") : QIcon(":/icons/table/sort_black.svg"));
-    m_undoAction->setIcon(isDarkMode ? QIcon(":/icons/table/undo_white.svg") : QIcon(":/icons/table/undo_black.svg"));
-    m_redoAction->setIcon(isDarkMode ? QIcon(":/icons/table/redo_white.svg") : QIcon(":/icons/table/redo_black.svg"));
+    auto& iconCache = IconCache::instance();
+
+    m_addCharacterAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/add_white.svg" : ":/icons/table/add_black.svg"));
+    m_insertTableAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/insert_table_white.svg" : ":/icons/table/insert_table_black.svg"));
+    m_removeAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/remove_white.svg" : ":/icons/table/remove_black.svg"));
+    m_addEffectAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/effect_white.svg" : ":/icons/table/effect_black.svg"));
+    m_duplicateAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/duplicate_white.svg" : ":/icons/table/duplicate_black.svg"));
+    m_rerollAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/reroll_white.svg" : ":/icons/table/reroll_black.svg"));
+    m_changeHPAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/change_hp_white.svg" : ":/icons/table/change_hp_black.svg"));
+    m_resortAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/sort_white.svg" : ":/icons/table/sort_black.svg"));
+    m_undoAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/undo_white.svg" : ":/icons/table/undo_black.svg"));
+    m_redoAction->setIcon(iconCache.getIcon(isDarkMode ? ":/icons/table/redo_white.svg" : ":/icons/table/redo_black.svg"));
 }
 
 
 void
 CombatWidget::openAddCharacterDialog()
 {
+    TRACE_SCOPE("CombatWidget::openAddCharacterDialog");
+
     // Resynchronize because the table could have been modified
     m_tableWidget->resynchronizeCharacters();
     const auto sizeBeforeDialog = m_characterHandler->getCharacters().size();
@@ -319,7 +491,7 @@ CombatWidget::openAddCharacterDialog()
     auto *const dialog = new AddCharacterDialog(m_additionalSettings.modAddedToIni, this);
     connect(dialog, &AddCharacterDialog::characterCreated, this, [this] (CharacterHandler::Character character, int instanceCount) {
         addCharacter(character, instanceCount);
-        emit tableHeightSet(m_tableWidget->getHeight() + 40);
+        m_layoutScheduler->markHeightDirty();
     });
 
     if (dialog->exec() == QDialog::Accepted) {
@@ -339,6 +511,8 @@ CombatWidget::openAddCharacterDialog()
 void
 CombatWidget::dragAndDrop(int /* logicalIndex */, int oldVisualIndex, int newVisualIndex)
 {
+    TRACE_SCOPE("CombatWidget::dragAndDrop");
+
     // @note
     // A section moved signal only applies to the header's view, not the model.
     // Also, for some reason, setting the table, which updates the model, seems to trigger the drag & drop an additional time.
@@ -346,14 +520,21 @@ CombatWidget::dragAndDrop(int /* logicalIndex */, int oldVisualIndex, int newVis
     // then reset after the section has been moved. Afterwards, a manual drag & drop is performed.
     m_tableWidget->verticalHeader()->restoreState(m_headerDataState);
     m_tableWidget->resynchronizeCharacters();
-
-    // Switch the character order according to the indices
+    saveOldState(true);
+
+    // Switch the character order according to the indices, the old indices are moved the same way for the journal
+    const auto moveRow = [oldVisualIndex, newVisualIndex] (auto& rows) {
+        if (oldVisualIndex > newVisualIndex) {
+            std::rotate(rows.rend() - oldVisualIndex - 1, rows.rend() - oldVisualIndex, rows.rend() - newVisualIndex);
+        } else {
+            std::rotate(rows.begin() + oldVisualIndex, rows.begin() + oldVisualIndex + 1, rows.begin() + newVisualIndex + 1);
+        }
+    };
     auto& characters = m_characterHandler->getCharacters();
-    if (oldVisualIndex > newVisualIndex) {
-        std::rotate(characters.rend() - oldVisualIndex - 1, characters.rend() - oldVisualIndex, characters.rend() - newVisualIndex);
-    } else {
-        std::rotate(characters.begin() + oldVisualIndex, characters.begin() + oldVisualIndex + 1, characters.begin() + newVisualIndex + 1);
-    }
+    m_movedRowSources.resize(characters.size());
+    std::iota(m_movedRowSources.begin(), m_movedRowSources.end(), 0);
+    moveRow(characters);
+    moveRow(m_movedRowSources);
     // Then set the table
     pushOnUndoStack();
 
@@ -366,6 +547,8 @@ CombatWidget::dragAndDrop(int /* logicalIndex */, int oldVisualIndex, int newVis
 void
 CombatWidget::insertTable()
 {
+    TRACE_SCOPE("CombatWidget::insertTable");
+
     const auto fileName = QFileDialog::getOpenFileName(this, "Insert other Table", "", ("lcm File(*.lcm)"));
     if (fileName.isEmpty()) {
         return;
@@ -382,7 +565,7 @@ CombatWidget::insertTable()
             m_removedOrAddedRowIndices.push_back(i);
         }
         pushOnUndoStack();
-        emit tableHeightSet(m_tableWidget->getHeight() + 40);
+        m_layoutScheduler->markHeightDirty();
 
         break;
     }
@@ -403,6 +586,8 @@ CombatWidget::insertTable()
 void
 CombatWidget::openStatusEffectDialog()
 {
+    TRACE_SCOPE("CombatWidget::openStatusEffectDialog");
+
     if (!m_tableWidget->selectionModel()->hasSelection()) {
         return;
     }
@@ -460,17 +645,22 @@ CombatWidget::openStatusEffectDialog()
 void
 CombatWidget::addCharacter(CharacterHandler::Character character, int instanceCount)
 {
+    TRACE_SCOPE("CombatWidget::addCharacter");
+
     saveOldState();
     m_tableWidget->resynchronizeCharacters();
 
     const auto trimmedName = character.name.trimmed();
+    auto& characters = m_characterHandler->getCharacters();
+    // A group is added as a single character, also keeping the hp of its instances
     for (auto i = 0; i < instanceCount; i++) {
-        m_characterHandler->storeCharacter(instanceCount > 1 && m_additionalSettings.indicatorMultipleChars ? trimmedName + " #" + QString::number(i + 1)
-                                                                                                            : trimmedName,
-                                           instanceCount > 1 && m_additionalSettings.rollIniMultipleChars ? Utils::General::rollDice() + character.modifier
-                                                                                                          : character.initiative,
-                                           character.modifier, character.hp, character.isEnemy, character.additionalInfoData);
-        m_removedOrAddedRowIndices.emplace_back(m_characterHandler->getCharacters().size() - 1);
+        auto instance = character;
+        instance.name = instanceCount > 1 && m_additionalSettings.indicatorMultipleChars ? trimmedName + " #" + QString::number(i + 1)
+                                                                                         : trimmedName;
+        instance.initiative = instanceCount > 1 && m_additionalSettings.rollIniMultipleChars ? Utils::General::rollDice() + character.modifier
+                                                                                             : character.initiative;
+        characters.push_back(instance);
+        m_removedOrAddedRowIndices.emplace_back(characters.size() - 1);
     }
 
     pushOnUndoStack();
@@ -480,6 +670,8 @@ CombatWidget::addCharacter(CharacterHandler::Character character, int instanceCo
 void
 CombatWidget::rerollIni()
 {
+    TRACE_SCOPE("CombatWidget::rerollIni");
+
     if (m_tableWidget->selectionModel()->selectedRows().size() != 1) {
         return;
     }
@@ -493,6 +685,7 @@ CombatWidget::rerollIni()
     const auto newInitiative = newRolledDice + characters.at(row).modifier;
 
     characters[row].initiative = newInitiative;
+    m_changedRowIndices = { row };
     pushOnUndoStack();
 
     // Reset the graphics effect and kickoff the animation
@@ -508,25 +701,44 @@ CombatWidget::rerollIni()
 void
 CombatWidget::changeHPForMultipleChars()
 {
-    if (m_tableWidget->selectionModel()->selectedRows().size() < 2) {
+    TRACE_SCOPE("CombatWidget::changeHPForMultipleChars");
+
+    const auto selectedRows = m_tableWidget->selectionModel()->selectedRows();
+    if (selectedRows.size() < 2 && (selectedRows.empty() || m_tableWidget->getInstanceCount(selectedRows.front().row()) < 2)) {
         return;
     }
 
-    if (auto *const dialog = new ChangeHPDialog(this); dialog->exec() == QDialog::Accepted) {
+    m_tableWidget->resynchronizeCharacters();
+    const auto& characters = m_characterHandler->getCharacters();
+    // Every instance of a group is a target on its own, so the instances can be damaged independently
+    QStringList names;
+    QVector<CharacterHandler::HpChange> hpChanges;
+    for (const auto& index : selectedRows) {
+        const auto& character = characters.at(index.row());
+        if (!character.isGroup()) {
+            names << character.name;
+            hpChanges.push_back({ index.row(), 0 });
+            continue;
+        }
+        for (auto i = 0; i < character.getInstanceCount(); i++) {
+            names << character.name + " #" + QString::number(i + 1) + " (" + QString::number(character.instanceHp.at(i)) + " HP)";
+            hpChanges.push_back({ index.row(), 0, CharacterHandler::HpRule::FULL, i });
+        }
+    }
+
+    if (auto *const dialog = new ChangeHPDialog(names, this); dialog->exec() == QDialog::Accepted) {
         const auto hpValue = dialog->getHPValue();
         if (hpValue == 0) {
             return;
         }
 
-        saveOldState();
-        m_tableWidget->resynchronizeCharacters();
-
-        auto& characters = m_characterHandler->getCharacters();
-        for (const auto& index : m_tableWidget->selectionModel()->selectedRows()) {
-            characters[index.row()].hp = std::clamp(characters[index.row()].hp + hpValue, -10000, 10000);
+        const auto hpRules = dialog->getHpRules();
+        for (auto i = 0; i < hpChanges.size(); i++) {
+            hpChanges[i].value = hpValue;
+            hpChanges[i].rule = hpRules.at(i);
         }
-
-        pushOnUndoStack();
+        // The dialog is modal, so the characters are still synchronized
+        applyHpChanges(hpChanges, true);
     }
 }
 
@@ -535,49 +747,75 @@ CombatWidget::changeHPForMultipleChars()
 void
 CombatWidget::removeRow()
 {
+    TRACE_SCOPE("CombatWidget::removeRow");
+
     if (!m_tableWidget->selectionModel()->hasSelection()) {
         return;
     }
 
-    saveOldState();
-    m_tableWidget->resynchronizeCharacters();
-
-    // Get selected rows indices
+    std::vector<int> rows;
     for (const auto& index : m_tableWidget->selectionModel()->selectedRows()) {
-        m_removedOrAddedRowIndices.emplace_back(index.row());
+        rows.push_back(index.row());
     }
+    removeRows(rows);
+    m_tableWidget->itemSelectionChanged();
+}
 
-    // Sort reversed so items in the vector can be removed without using offsets
-    std::sort(m_removedOrAddedRowIndices.begin(), m_removedOrAddedRowIndices.end(), [](const auto& a, const auto& b) {
-        return a > b;
-    });
+
+void
+CombatWidget::removeRows(const std::vector<int>& rows)
+{
+    TRACE_SCOPE("CombatWidget::removeRows");
+
+    m_tableWidget->resynchronizeCharacters();
+    saveOldState(true);
 
     auto& characters = m_characterHandler->getCharacters();
-    for (const auto& index : m_removedOrAddedRowIndices) {
-        // If the deleted row is before the current entered row, move one up
-        if (index < (int) m_rowEntered) {
-            m_rowEntered--;
-        } else if (index == m_tableWidget->rowCount() - 1 && m_tableWidget->item(index, Utils::Table::COL_NAME)->font().bold()) {
-            // If the deleted row was the last one in the table and also the current player, select to the first row
-            m_rowEntered = 0;
+    std::vector<bool> isRemoved(characters.size(), false);
+    for (const auto row : rows) {
+        if (row >= 0 && row < characters.size()) {
+            isRemoved[row] = true;
         }
+    }
 
-        characters.remove(index);
+    // Compact the remaining characters in a single pass, collecting the removed rows in ascending order
+    auto removedBeforeEntered = 0;
+    auto keptCount = 0;
+    for (auto i = 0; i < characters.size(); i++) {
+        if (isRemoved[i]) {
+            m_removedOrAddedRowIndices.push_back(i);
+            if (i < (int) m_rowEntered) {
+                removedBeforeEntered++;
+            }
+            continue;
+        }
+        if (keptCount != i) {
+            characters[keptCount] = std::move(characters[i]);
+        }
+        keptCount++;
+    }
+    if (m_removedOrAddedRowIndices.empty()) {
+        return;
     }
+    characters.erase(characters.begin() + keptCount, characters.end());
 
-    // Reverse for the undo stack removal operation
-    std::reverse(m_removedOrAddedRowIndices.begin(), m_removedOrAddedRowIndices.end());
+    // Rows deleted before the current entered row move it up. If it was deleted at the end of the table, start at the first row
+    m_rowEntered -= removedBeforeEntered;
+    if ((int) m_rowEntered >= characters.size()) {
+        m_rowEntered = 0;
+    }
 
     // Update the current player row and table
     setRowAndPlayer();
     pushOnUndoStack();
-    m_tableWidget->itemSelectionChanged();
 }
 
 
 void
 CombatWidget::duplicateRow()
 {
+    TRACE_SCOPE("CombatWidget::duplicateRow");
+
     if (m_tableWidget->selectionModel()->selectedRows().size() != 1) {
         return;
     }
@@ -595,9 +833,58 @@ CombatWidget::duplicateRow()
 }
 
 
+void
+CombatWidget::expandGroup()
+{
+    TRACE_SCOPE("CombatWidget::expandGroup");
+
+    if (m_tableWidget->selectionModel()->selectedRows().size() != 1 ||
+        m_tableWidget->getInstanceCount(m_tableWidget->currentRow()) < 2) {
+        return;
+    }
+
+    const auto row = m_tableWidget->currentRow();
+    m_tableWidget->resynchronizeCharacters();
+    auto& characters = m_characterHandler->getCharacters();
+    const auto instances = characters.at(row).getInstances(m_additionalSettings.indicatorMultipleChars);
+
+    // Replacing the group row is a removal followed by an insertion, undone as a single step
+    m_undoStack->beginMacro(tr("Expand Group"));
+
+    const auto rowEnteredOld = m_rowEntered;
+    saveOldState();
+    characters.remove(row);
+    m_removedOrAddedRowIndices.emplace_back(row);
+    if (row < (int) rowEnteredOld) {
+        m_rowEntered--;
+    } else if ((int) m_rowEntered >= characters.size()) {
+        m_rowEntered = 0;
+    }
+    pushOnUndoStack();
+
+    saveOldState();
+    for (auto i = 0; i < instances.size(); i++) {
+        characters.insert(row + i, instances.at(i));
+        m_removedOrAddedRowIndices.emplace_back(row + i);
+    }
+    // If the group was the current player, its first instance is now
+    m_rowEntered = row < (int) rowEnteredOld ? rowEnteredOld + instances.size() - 1 : rowEnteredOld;
+    pushOnUndoStack();
+
+    m_undoStack->endMacro();
+
+    setRowAndPlayer();
+    m_layoutScheduler->markHeightDirty();
+    m_tableWidget->itemSelectionChanged();
+}
+
+
 void
 CombatWidget::handleTableWidgetItemPressed(QTableWidgetItem *item)
 {
+    TRACE_SCOPE("CombatWidget::handleTableWidgetItemPressed");
+
+    startAction("Edit Cell");
     if (item->column() == Utils::Table::COL_NAME) {
         const auto nameWidth = Utils::General::getStringWidth(item->text());
         resetNameAndInfoWidth(nameWidth, m_tableWidget->columnWidth(Utils::Table::COL_ADDITIONAL));
@@ -614,11 +901,10 @@ CombatWidget::handleTableWidgetItemPressed(QTableWidgetItem *item)
         m_tableWidget->blockSignals(false);
         return;
     }
-    const auto& tableData = m_tableWidget->tableDataFromWidget();
-
-    if (tableData != m_tableDataOld || m_rowEnteredOld != m_rowEntered || m_roundCounterOld != m_roundCounter) {
-        m_tableWidget->resynchronizeCharacters();
-        pushOnUndoStack();
+    // Only the edited rows are hashed again
+    if (m_tableWidget->getTableFingerprint() != m_tableFingerprintOld ||
+        m_rowEnteredOld != m_rowEntered || m_roundCounterOld != m_roundCounter) {
+        pushOnUndoStack(true);
     }
 }
 
@@ -626,6 +912,8 @@ CombatWidget::handleTableWidgetItemPressed(QTableWidgetItem *item)
 void
 CombatWidget::sortTable()
 {
+    TRACE_SCOPE("CombatWidget::sortTable");
+
     if (m_tableWidget->rowCount() <= 1) {
         return;
     }
@@ -633,7 +921,7 @@ CombatWidget::sortTable()
     saveOldState();
     // Main sorting
     m_tableWidget->resynchronizeCharacters();
-    m_characterHandler->sortCharacters(m_ruleSettings.ruleset, m_ruleSettings.rollAutomatical);
+    m_movedRowSources = m_characterHandler->sortCharacters(m_ruleSettings.ruleset, m_ruleSettings.rollAutomatical);
     m_rowEntered = 0;
     pushOnUndoStack();
 }
@@ -649,6 +937,8 @@ CombatWidget::setRowAndPlayer() const
 void
 CombatWidget::switchCharacterPosition(bool goDown)
 {
+    TRACE_SCOPE("CombatWidget::switchCharacterPosition");
+
     // Do not fall out of table bounds
     const auto originalIndex = m_tableWidget->currentRow();
     if ((originalIndex == 0 && !goDown) || (originalIndex == m_tableWidget->rowCount() - 1 && goDown)) {
@@ -661,6 +951,10 @@ CombatWidget::switchCharacterPosition(bool goDown)
     auto& characters = m_characterHandler->getCharacters();
     const auto indexToSwap = goDown ? 1 : -1;
     std::iter_swap(characters.begin() + originalIndex, characters.begin() + originalIndex + indexToSwap);
+    m_movedRowSources.resize(characters.size());
+    std::iota(m_movedRowSources.begin(), m_movedRowSources.end(), 0);
+    std::iter_swap(m_movedRowSources.begin() + originalIndex, m_movedRowSources.begin() + originalIndex + indexToSwap);
+    m_changedRowIndices = { std::min(originalIndex, originalIndex + indexToSwap), std::max(originalIndex, originalIndex + indexToSwap) };
 
     setRowAndPlayer();
     pushOnUndoStack();
@@ -675,6 +969,8 @@ CombatWidget::switchCharacterPosition(bool goDown)
 void
 CombatWidget::enteredRowChanged(bool isGoingDown)
 {
+    TRACE_SCOPE("CombatWidget::enteredRowChanged");
+
     if (m_tableWidget->rowCount() == 0 || (!isGoingDown && m_rowEntered == 0 && m_roundCounter == 1)) {
         return;
     }
@@ -701,25 +997,33 @@ CombatWidget::enteredRowChanged(bool isGoingDown)
 
 void
 CombatWidget::setTableOption(bool option, int valueType)
+{
+    TRACE_SCOPE("CombatWidget::setTableOption");
+
+    // Applied once the settings store reports the change
+    m_tableSettings.write(static_cast<TableSettings::ValueType>(valueType), option);
+}
+
+
+void
+CombatWidget::applyTableOption(bool option, TableSettings::ValueType valueType)
 {
     switch (valueType) {
-    case 0:
+    case TableSettings::ValueType::INI_SHOWN:
         m_tableWidget->setColumnHidden(Utils::Table::COL_INI, !option);
         break;
-    case 1:
+    case TableSettings::ValueType::MOD_SHOWN:
         m_tableWidget->setColumnHidden(Utils::Table::COL_MODIFIER, !option);
         break;
-    case 2:
+    case TableSettings::ValueType::COLOR_TABLE:
         m_tableWidget->setTableRowColor(!option);
         break;
-    case 3:
+    case TableSettings::ValueType::SHOW_INI_TOOLTIPS:
         m_tableWidget->setIniColumnTooltips(!option);
         break;
     default:
         break;
     }
-
-    m_tableSettings.write(static_cast<TableSettings::ValueType>(valueType), option);
 }
 
 
@@ -750,10 +1054,20 @@ CombatWidget::loadCharactersFromTable(const QJsonObject& jsonObject)
             additionalInfoData.statusEffects.push_back(effect);
         }
 
-        characters.push_back(CharacterHandler::Character {
-            characterObject.value("name").toString(), characterObject.value("initiative").toInt(),
-            characterObject.value("modifier").toInt(), characterObject.value("hp").toInt(),
-            characterObject.value("is_enemy").toBool(), additionalInfoData });
+        CharacterHandler::Character loadedCharacter(characterObject.value("name").toString(), characterObject.value("initiative").toInt(),
+                                                    characterObject.value("modifier").toInt(), characterObject.value("hp").toInt(),
+                                                    characterObject.value("is_enemy").toBool(), additionalInfoData);
+
+        // Groups
+        if (const auto& instanceHpArray = characterObject.value("instance_hp").toArray(); !instanceHpArray.isEmpty()) {
+            QVector<int> instanceHp;
+            instanceHp.reserve(instanceHpArray.size());
+            for (const auto& value : instanceHpArray) {
+                instanceHp.push_back(value.toInt());
+            }
+            loadedCharacter.setInstanceHp(instanceHp);
+        }
+        characters.push_back(loadedCharacter);
     }
 }
 
@@ -766,6 +1080,9 @@ CombatWidget::createAction(const QString& text, const QString& toolTip, const QK
     action->setShortcut(keySequence);
     action->setEnabled(enabled);
     action->setShortcutVisibleInContextMenu(true);
+    connect(action, &QAction::triggered, this, [this, actionName = QString(text).remove('&')] {
+        startAction(actionName);
+    });
 
     return action;
 }
@@ -800,6 +1117,10 @@ CombatWidget::contextMenuEvent(QContextMenuEvent *event)
                 editingMenu->addAction(m_changeHPAction);
             } else {
                 editingMenu->addAction(m_duplicateAction);
+                if (m_tableWidget->getInstanceCount(currentRow) > 1) {
+                    editingMenu->addAction(m_changeHPAction);
+                    editingMenu->addAction(m_expandGroupAction);
+                }
                 editingMenu->addAction(m_rerollAction);
                 editingMenu->addAction(m_moveUpwardAction);
                 editingMenu->addAction(m_moveDownwardAction);
@@ -2,9 +2,13 @@
 
 #include "CharacterHandler.hpp"
 #include "CombatTableWidget.hpp"
+#include "LatencyMonitor.hpp"
+#include "LayoutScheduler.hpp"
 #include "TableFileHandler.hpp"
+#include "TableJournal.hpp"
 #include "TableSettings.hpp"
 
+#include <QFuture>
 #include <QJsonObject>
 #include <QPointer>
 #include <QWidget>
@@ -38,6 +42,12 @@ public:
         return m_tableWidget;
     }
 
+    [[nodiscard]] LayoutScheduler*
+    getLayoutScheduler() const
+    {
+        return m_layoutScheduler;
+    }
+
     [[nodiscard]] bool
     isEmpty() const
     {
@@ -50,19 +60,63 @@ public:
         return m_tableWidget->getHeight() + 40;
     }
 
+    [[nodiscard]] unsigned int
+    getRowEntered() const
+    {
+        return m_rowEntered;
+    }
+
+    [[nodiscard]] unsigned int
+    getRoundCounter() const
+    {
+        return m_roundCounter;
+    }
+
+    // Called by the undo commands for every applied change
+    void
+    addJournalOperation(const TableJournal::Operation& operation)
+    {
+        m_journalOperations.push_back(operation);
+    }
+
+    // Operations applied to the table since the last call, used for the autosave journal
+    [[nodiscard]] QVector<TableJournal::Operation>
+    takeJournalOperations();
+
     [[nodiscard]] bool
     writeTableToFile(const QString& fileName);
 
+    // Snapshot the table, then serialize and write it on a worker thread
+    [[nodiscard]] QFuture<bool>
+    writeTableToFileAsync(const QString& fileName);
+
     void
-    saveOldState();
+    saveOldState(bool isSynchronized = false);
 
     void
     pushOnUndoStack(bool resynchronize = false);
 
+    // Apply damage or healing with a different value and rule per character, undone as a single step storing only the hp values
+    void
+    applyHpChanges(const QVector<CharacterHandler::HpChange>& hpChanges,
+                   bool                                       isSynchronized = false);
+
+    // Remove all given rows at once, undone as a single step
+    void
+    removeRows(const std::vector<int>& rows);
+
+    // Count the following layout passes and measure the latency until the next paint for this action
+    void
+    startAction(const QString& action);
+
     void
     resetNameAndInfoWidth(const int nameWidth,
                           const int addInfoWidth);
 
+    // Widen the name and additional info columns to the widest entries of the given rows at once
+    void
+    resetNameAndInfoWidths(const std::vector<int>& rows);
+
     void
     setUndoRedoIcon(bool isDarkMode);
 
@@ -117,6 +171,10 @@ private slots:
     void
     duplicateRow();
 
+    // Replace a group by single rows for all of its instances
+    void
+    expandGroup();
+
     void
     handleTableWidgetItemPressed(QTableWidgetItem *item);
 
@@ -137,6 +195,10 @@ private:
     setTableOption(bool option,
                    int  valueType);
 
+    void
+    applyTableOption(bool                     option,
+                     TableSettings::ValueType valueType);
+
     void
     loadCharactersFromTable(const QJsonObject& jsonObject);
 
@@ -158,6 +220,9 @@ private:
 
     QPointer<QUndoStack> m_undoStack;
 
+    QPointer<LayoutScheduler> m_layoutScheduler;
+    QPointer<LatencyMonitor> m_latencyMonitor;
+
     QPointer<QTimer> m_timer;
 
     QPointer<QAction> m_addCharacterAction;
@@ -165,6 +230,7 @@ private:
     QPointer<QAction> m_removeAction;
     QPointer<QAction> m_addEffectAction;
     QPointer<QAction> m_duplicateAction;
+    QPointer<QAction> m_expandGroupAction;
     QPointer<QAction> m_rerollAction;
     QPointer<QAction> m_changeHPAction;
     QPointer<QAction> m_undoAction;
@@ -180,9 +246,17 @@ private:
     const RuleSettings& m_ruleSettings;
     TableSettings m_tableSettings;
 
-    QVector<QVector<QVariant> > m_tableDataOld;
+    QVector<CharacterHandler::Character> m_tableDataOld;
+    QVector<quint64> m_rowFingerprintsOld;
+    quint64 m_tableFingerprintOld{ 0 };
 
     std::vector<int> m_removedOrAddedRowIndices;
+    // Set if the changed rows are already known before pushing on the undo stack
+    std::vector<int> m_changedRowIndices;
+    // Old index of every row, set if the rows have only been reordered
+    QVector<int> m_movedRowSources;
+
+    QVector<TableJournal::Operation> m_journalOperations;
 
     QByteArray m_headerDataState;
 
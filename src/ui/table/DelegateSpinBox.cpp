@@ -3,7 +3,7 @@
 #include <QSpinBox>
 
 DelegateSpinBox::DelegateSpinBox(QObject *parent)
-    : QStyledItemDelegate(parent)
+    : CombatTableDelegate(parent)
 {
 }
 
@@ -1,9 +1,9 @@
 #pragma once
 
-#include <QStyledItemDelegate>
+#include "CombatTableDelegate.hpp"
 
 // Small helper class so that the hp column in the table contains spinboxes
-class DelegateSpinBox : public QStyledItemDelegate
+class DelegateSpinBox : public CombatTableDelegate
 {
     Q_OBJECT
 
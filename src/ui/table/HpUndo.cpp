@@ -0,0 +1,63 @@
+#include "HpUndo.hpp"
+
+#include "CombatTableWidget.hpp"
+#include "CombatWidget.hpp"
+#include "UtilsTrace.hpp"
+
+HpUndo::HpUndo(CombatWidget* combatWidget, std::shared_ptr<CharacterHandler> characterHandler,
+               const QVector<HpValue>& hpValues) :
+    m_combatWidget(combatWidget), m_characterHandler(std::move(characterHandler)), m_hpValues(hpValues)
+{
+}
+
+
+void
+HpUndo::undo()
+{
+    setHpValues(true);
+}
+
+
+void
+HpUndo::redo()
+{
+    setHpValues(false);
+}
+
+
+void
+HpUndo::setHpValues(bool undo)
+{
+    TRACE_SCOPE("HpUndo::setHpValues");
+
+    auto *const tableWidget = m_combatWidget->getCombatTableWidget();
+    auto& characters = m_characterHandler->getCharacters();
+
+    // Setting the items would recall the undo stack
+    tableWidget->blockSignals(true);
+    for (auto i = 0; i < m_hpValues.size(); i++) {
+        const auto& hpValue = m_hpValues.at(i);
+        auto& character = characters[hpValue.row];
+        const auto value = undo ? hpValue.oldHp : hpValue.newHp;
+        if (hpValue.instance < 0) {
+            character.hp = value;
+        } else {
+            auto instanceHp = character.instanceHp;
+            instanceHp[hpValue.instance] = value;
+            character.setInstanceHp(instanceHp);
+        }
+
+        // The values of a row are stored next to each other, so every row is written once
+        if (i == m_hpValues.size() - 1 || m_hpValues.at(i + 1).row != hpValue.row) {
+            tableWidget->setHpItem(hpValue.row, character);
+
+            TableJournal::Operation operation;
+            operation.row = hpValue.row;
+            operation.character = character;
+            m_combatWidget->addJournalOperation(operation);
+        }
+    }
+    tableWidget->blockSignals(false);
+
+    emit m_combatWidget->changeOccured();
+}
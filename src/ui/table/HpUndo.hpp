@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CharacterHandler.hpp"
+
+#include <QPointer>
+#include <QUndoCommand>
+
+#include <memory>
+
+class CombatWidget;
+
+// Undo and redo hp changes by writing only the changed hp cells
+class HpUndo : public QUndoCommand
+{
+public:
+    struct HpValue {
+        int row;
+        // Instance of a group, negative for single characters
+        int instance;
+        int oldHp;
+        int newHp;
+    };
+
+public:
+    HpUndo(CombatWidget*                     combatWidget,
+           std::shared_ptr<CharacterHandler> characterHandler,
+           const QVector<HpValue>&           hpValues);
+
+    void
+    undo() override;
+
+    void
+    redo() override;
+
+private:
+    void
+    setHpValues(bool undo);
+
+private:
+    QPointer<CombatWidget> m_combatWidget;
+    std::shared_ptr<CharacterHandler> m_characterHandler;
+
+    const QVector<HpValue> m_hpValues;
+};
@@ -0,0 +1,97 @@
+#include "LatencyMonitor.hpp"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cmath>
+
+LatencyMonitor::LatencyMonitor(QObject *parent) :
+    QObject(parent),
+    m_isEnabled(qEnvironmentVariableIsSet("LCM_LATENCY"))
+{
+}
+
+
+LatencyMonitor::~LatencyMonitor()
+{
+    if (m_isEnabled && !m_samples.isEmpty()) {
+        qInfo().noquote() << getReport();
+    }
+}
+
+
+void
+LatencyMonitor::start(const QString& action)
+{
+    if (!m_isEnabled) {
+        return;
+    }
+    m_pendingAction = action;
+    m_timer.start();
+}
+
+
+void
+LatencyMonitor::finish()
+{
+    if (m_pendingAction.isEmpty()) {
+        return;
+    }
+
+    if (const auto latency = m_timer.nsecsElapsed() / 1000; latency <= MAX_LATENCY) {
+        addSample(m_pendingAction, latency);
+    }
+    m_pendingAction.clear();
+}
+
+
+void
+LatencyMonitor::addSample(const QString& action, qint64 latency)
+{
+    auto& samples = m_samples[action];
+    // Keep the most recent samples
+    if (samples.size() >= MAX_SAMPLES) {
+        samples.removeFirst();
+    }
+    samples.push_back(latency);
+}
+
+
+LatencyMonitor::Statistics
+LatencyMonitor::getStatistics(const QString& action) const
+{
+    const auto samples = m_samples.value(action);
+    if (samples.empty()) {
+        return Statistics();
+    }
+    return Statistics{ (int) samples.size(), getPercentile(samples, 50), getPercentile(samples, 95), getPercentile(samples, 99) };
+}
+
+
+QString
+LatencyMonitor::getReport() const
+{
+    auto actions = m_samples.keys();
+    actions.sort();
+
+    QString report = "Input to paint latency (us):";
+    for (const auto& action : actions) {
+        const auto statistics = getStatistics(action);
+        report += QString("\n%1: n = %2, p50 = %3, p95 = %4, p99 = %5").arg(action).arg(statistics.count)
+                  .arg(statistics.p50).arg(statistics.p95).arg(statistics.p99);
+    }
+    return report;
+}
+
+
+qint64
+LatencyMonitor::getPercentile(QVector<qint64> samples, double percentile)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+
+    const auto rank = std::max((int) std::ceil(percentile * samples.size() / 100.0), 1);
+    std::nth_element(samples.begin(), samples.begin() + rank - 1, samples.end());
+    return samples.at(rank - 1);
+}
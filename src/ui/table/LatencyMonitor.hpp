@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QVector>
+
+// Measures the time from a triggered action until the table has been repainted.
+// The latencies are collected per action and reported as percentiles when the monitor is destroyed.
+// Only active if the LCM_LATENCY environment variable is set.
+class LatencyMonitor : public QObject {
+    Q_OBJECT
+
+public:
+    struct Statistics {
+        int    count{ 0 };
+        qint64 p50{ 0 };
+        qint64 p95{ 0 };
+        qint64 p99{ 0 };
+    };
+
+public:
+    explicit
+    LatencyMonitor(QObject *parent = nullptr);
+
+    ~LatencyMonitor();
+
+    [[nodiscard]] bool
+    isEnabled() const
+    {
+        return m_isEnabled;
+    }
+
+    void
+    setEnabled(bool enabled)
+    {
+        m_isEnabled = enabled;
+    }
+
+    // Timestamp a triggered action, a previously started action without paint is dropped
+    void
+    start(const QString& action);
+
+    // Called after the table has been painted, completes the started action
+    void
+    finish();
+
+    // Latency in microseconds
+    void
+    addSample(const QString& action,
+              qint64         latency);
+
+    [[nodiscard]] Statistics
+    getStatistics(const QString& action) const;
+
+    [[nodiscard]] QString
+    getReport() const;
+
+    // Nearest rank percentile of the given samples
+    [[nodiscard]] static qint64
+    getPercentile(QVector<qint64> samples,
+                  double          percentile);
+
+private:
+    QHash<QString, QVector<qint64> > m_samples;
+
+    QElapsedTimer m_timer;
+    QString m_pendingAction;
+
+    bool m_isEnabled;
+
+    // Actions which do not cause a paint would otherwise be measured until an unrelated paint
+    static constexpr qint64 MAX_LATENCY = 5000000;
+    static constexpr int MAX_SAMPLES = 10000;
+};
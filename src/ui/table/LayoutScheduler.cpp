@@ -0,0 +1,70 @@
+#include "LayoutScheduler.hpp"
+
+#include <QDebug>
+
+LayoutScheduler::LayoutScheduler(QObject *parent) :
+    QObject(parent),
+    m_isLoggingEnabled(qEnvironmentVariableIsSet("LCM_LAYOUT_STATS"))
+{
+    // Zero interval, so the passes run as soon as the current event has been handled
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(0);
+    connect(&m_timer, &QTimer::timeout, this, &LayoutScheduler::flush);
+}
+
+
+void
+LayoutScheduler::markWidthDirty()
+{
+    m_passCounts[m_action].widthRequests++;
+    m_isWidthDirty = true;
+    schedule();
+}
+
+
+void
+LayoutScheduler::markHeightDirty()
+{
+    m_passCounts[m_action].heightRequests++;
+    m_isHeightDirty = true;
+    schedule();
+}
+
+
+void
+LayoutScheduler::flush()
+{
+    m_timer.stop();
+    if (!isPending()) {
+        return;
+    }
+
+    // Reset before emitting, so passes may request further passes
+    if (m_isWidthDirty) {
+        m_isWidthDirty = false;
+        m_passCounts[m_pendingAction].widthPasses++;
+        emit widthPassRequested();
+    }
+    if (m_isHeightDirty) {
+        m_isHeightDirty = false;
+        m_passCounts[m_pendingAction].heightPasses++;
+        emit heightPassRequested();
+    }
+
+    if (m_isLoggingEnabled) {
+        const auto& count = m_passCounts.value(m_pendingAction);
+        qDebug().nospace() << "Layout (" << m_pendingAction << "): "
+                           << count.widthRequests << " width requests, " << count.widthPasses << " passes, "
+                           << count.heightRequests << " height requests, " << count.heightPasses << " passes";
+    }
+}
+
+
+void
+LayoutScheduler::schedule()
+{
+    if (!m_timer.isActive()) {
+        m_pendingAction = m_action;
+        m_timer.start();
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+
+// Coalesces the table layout passes. Width and height are only marked as dirty
+// and recalculated once in the next event loop iteration, no matter how often they were requested.
+// Setting LCM_LAYOUT_STATS logs the number of requests and passes for each action.
+class LayoutScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    struct PassCount {
+        int widthRequests{ 0 };
+        int heightRequests{ 0 };
+        int widthPasses{ 0 };
+        int heightPasses{ 0 };
+    };
+
+public:
+    explicit
+    LayoutScheduler(QObject *parent = nullptr);
+
+    void
+    markWidthDirty();
+
+    void
+    markHeightDirty();
+
+    // Run all pending passes immediately
+    void
+    flush();
+
+    // The following requests and passes are counted for this action
+    void
+    setAction(const QString& action)
+    {
+        m_action = action;
+    }
+
+    [[nodiscard]] bool
+    isPending() const
+    {
+        return m_isWidthDirty || m_isHeightDirty;
+    }
+
+    [[nodiscard]] PassCount
+    getPassCount(const QString& action) const
+    {
+        return m_passCounts.value(action);
+    }
+
+signals:
+    void
+    widthPassRequested();
+
+    void
+    heightPassRequested();
+
+private:
+    void
+    schedule();
+
+private:
+    QTimer m_timer;
+
+    QHash<QString, PassCount> m_passCounts;
+
+    QString m_action;
+    // Action which caused the first request of the pending passes
+    QString m_pendingAction;
+
+    bool m_isWidthDirty{ false };
+    bool m_isHeightDirty{ false };
+
+    const bool m_isLoggingEnabled;
+};
@@ -3,16 +3,18 @@
 #include "CombatWidget.hpp"
 #include "CombatTableWidget.hpp"
 #include "UtilsTable.hpp"
+#include "UtilsTrace.hpp"
 
 #include <QLabel>
 #include <QObject>
 
 Undo::Undo(CombatWidget *CombatWidget, QPointer<QLabel> roundCounterLabel, QPointer<QLabel> currentPlayerLabel,
            const UndoData& oldData, const UndoData& newData, const std::vector<int> affectedRows,
-           unsigned int* rowEntered, unsigned int* roundCounter,
-           bool colorTableRows, bool showIniToolTips) :
+           const std::vector<int> changedRows, const QVector<int> sourceRows, unsigned int* rowEntered,
+           unsigned int* roundCounter, bool colorTableRows, bool showIniToolTips) :
     m_combatWidget(CombatWidget), m_roundCounterLabel(roundCounterLabel), m_currentPlayerLabel(currentPlayerLabel),
     m_oldData(std::move(oldData)), m_newData(std::move(newData)), m_affectedRows(std::move(affectedRows)),
+    m_changedRows(std::move(changedRows)), m_sourceRows(std::move(sourceRows)),
     m_rowEntered(rowEntered), m_roundCounter(roundCounter),
     m_colorTableRows(colorTableRows), m_showIniToolTips(showIniToolTips)
 {
@@ -36,6 +38,8 @@ Undo::redo()
 void
 Undo::setCombatWidget(bool undo)
 {
+    TRACE_SCOPE("Undo::setCombatWidget");
+
     // Set with old or new values, depending on if we are undoing or not
     auto *const tableWidget = m_combatWidget->getCombatTableWidget();
     const auto& oldTableData = m_oldData.tableData;
@@ -46,25 +50,29 @@ Undo::setCombatWidget(bool undo)
     tableWidget->blockSignals(true);
 
     // Insert or remove rows if the corresponding operations were called
+    const auto addRow = (oldTableData.size() > newTableData.size() && undo) ||
+                        (oldTableData.size() < newTableData.size() && !undo);
     if (!m_affectedRows.empty()) {
-        adjustTableWidgetRowCount((oldTableData.size() > newTableData.size() && undo) ||
-                                  (oldTableData.size() < newTableData.size() && !undo));
+        adjustTableWidgetRowCount(addRow);
+        // The columns are never shortened, so only inserted rows have to be measured.
+        // If a table is loaded, all of its rows are inserted
+        if (addRow) {
+            m_combatWidget->resetNameAndInfoWidths(m_affectedRows);
+        }
     } else {
         // For everything else, we just need to update the changed items
-        for (auto row = 0; row < oldTableData.size(); row++) {
-            if (oldTableData.at(row) == newTableData.at(row)) {
-                continue;
-            }
-
+        for (const auto row : m_changedRows) {
             const auto& rowData = undo ? oldTableData.at(row) : newTableData.at(row);
             for (auto col = 0; col < COL_COUNT; col++) {
-                if (oldTableData.at(row).at(col) == newTableData.at(row).at(col)) {
+                if (isCellEqual(oldTableData.at(row), newTableData.at(row), col)) {
                     continue;
                 }
 
-                fillTableWidgetCell(rowData.at(col), row, col);
+                fillTableWidgetCell(rowData, row, col);
             }
         }
+        // Created or changed cell widgets do not resize the columns on their own
+        m_combatWidget->resetNameAndInfoWidths(m_changedRows);
     }
 
     const auto& undoData = undo ? m_oldData : m_newData;
@@ -74,13 +82,15 @@ Undo::setCombatWidget(bool undo)
         *m_roundCounter = undoData.roundCounter;
     }
 
+    addJournalOperations(undo, addRow);
+
     // Set the remaining label and font data
     m_roundCounterLabel->setText(QObject::tr("Round ") + QString::number(undoData.roundCounter));
     tableWidget->setRowAndPlayer(m_roundCounterLabel, m_currentPlayerLabel, undoData.rowEntered);
     tableWidget->setTableRowColor(!m_colorTableRows);
     tableWidget->setIniColumnTooltips(!m_showIniToolTips);
 
-    emit m_combatWidget->tableHeightSet(tableWidget->getHeight());
+    m_combatWidget->getLayoutScheduler()->markHeightDirty();
     emit m_combatWidget->changeOccured();
 
     tableWidget->blockSignals(false);
@@ -88,23 +98,55 @@ Undo::setCombatWidget(bool undo)
 
 
 void
-Undo::fillTableWidgetCell(const QVariant& data, int row, int col)
+Undo::fillTableWidgetCell(const CharacterHandler::Character& character, int row, int col)
 {
     auto *const tableWidget = m_combatWidget->getCombatTableWidget();
 
+    QString text;
     switch (col) {
     case COL_ENEMY:
         tableWidget->setItem(row, COL_ENEMY, new QTableWidgetItem());
-        tableWidget->item(row, COL_ENEMY)->setCheckState(data.toBool() ? Qt::Checked : Qt::Unchecked);
-        break;
+        tableWidget->item(row, COL_ENEMY)->setCheckState(character.isEnemy ? Qt::Checked : Qt::Unchecked);
+        return;
     case COL_ADDITIONAL:
-        Utils::Table::setTableAdditionalInfoWidget(m_combatWidget, row, data);
+        Utils::Table::setTableAdditionalInfoWidget(m_combatWidget, row, character.additionalInfoData);
+        return;
+    case Utils::Table::COL_HP:
+        tableWidget->setHpItem(row, character);
+        return;
+    case Utils::Table::COL_NAME:
+        text = character.name;
         break;
-    default:
-        tableWidget->item(row, col) ? tableWidget->item(row, col)->setText(data.toString())
-                                    : tableWidget->setItem(row, col, new QTableWidgetItem(data.toString()));
+    case Utils::Table::COL_INI:
+        text = QString::number(character.initiative);
+        break;
+    case Utils::Table::COL_MODIFIER:
+        text = QString::number(character.modifier);
         break;
     }
+
+    tableWidget->item(row, col) ? tableWidget->item(row, col)->setText(text)
+                                : tableWidget->setItem(row, col, new QTableWidgetItem(text));
+}
+
+
+bool
+Undo::isCellEqual(const CharacterHandler::Character& first, const CharacterHandler::Character& second, int col)
+{
+    switch (col) {
+    case Utils::Table::COL_NAME:
+        return first.name == second.name;
+    case Utils::Table::COL_INI:
+        return first.initiative == second.initiative;
+    case Utils::Table::COL_MODIFIER:
+        return first.modifier == second.modifier;
+    case Utils::Table::COL_HP:
+        return first.hp == second.hp && first.instanceHp == second.instanceHp;
+    case COL_ENEMY:
+        return first.isEnemy == second.isEnemy;
+    default:
+        return first.additionalInfoData == second.additionalInfoData;
+    }
 }
 
 
@@ -112,24 +154,80 @@ void
 Undo::adjustTableWidgetRowCount(bool addRow)
 {
     auto *const tableWidget = m_combatWidget->getCombatTableWidget();
-    auto affectedRows = m_affectedRows;
-    const auto& oldTableData = m_oldData.tableData;
-    const auto& newTableData = m_newData.tableData;
+    const auto& biggerTableData = m_oldData.tableData.size() > m_newData.tableData.size() ? m_oldData.tableData : m_newData.tableData;
 
-    while (!affectedRows.empty()) {
-        const auto front = affectedRows.front();
-        addRow ? tableWidget->insertRow(front) : tableWidget->removeRow(front);
+    // The affected rows are ascending indices of the bigger table, so contiguous runs can be handled at once
+    std::vector<std::pair<int, int> > runs;
+    for (const auto row : m_affectedRows) {
+        if (!runs.empty() && runs.back().first + runs.back().second == row) {
+            runs.back().second++;
+        } else {
+            runs.emplace_back(row, 1);
+        }
+    }
 
-        if (addRow) {
-            const auto& tableData = oldTableData.size() > newTableData.size() ? oldTableData.at(front) : newTableData.at(front);
-            for (auto col = 0; col < COL_COUNT; col++) {
-                fillTableWidgetCell(tableData.at(col), front, col);
+    if (addRow) {
+        // Inserting in ascending order places every run at its final position
+        for (const auto& [firstRow, count] : runs) {
+            tableWidget->model()->insertRows(firstRow, count);
+            for (auto row = firstRow; row < firstRow + count; row++) {
+                for (auto col = 0; col < COL_COUNT; col++) {
+                    fillTableWidgetCell(biggerTableData.at(row), row, col);
+                }
             }
-        } else {
-            for (std::size_t i = 0; i < affectedRows.size(); i++) {
-                affectedRows[i]--;
+        }
+        return;
+    }
+
+    // Removing in descending order keeps the indices of the remaining runs valid
+    for (auto it = runs.rbegin(); it != runs.rend(); ++it) {
+        tableWidget->model()->removeRows(it->first, it->second);
+    }
+}
+
+
+void
+Undo::addJournalOperations(bool undo, bool addRow)
+{
+    // Reordered rows only store their old indices
+    if (!m_sourceRows.isEmpty()) {
+        if (!undo) {
+            m_combatWidget->addJournalOperation(TableJournal::createOrderOperation(m_sourceRows));
+            return;
+        }
+        QVector<int> sourceRows(m_sourceRows.size());
+        for (auto i = 0; i < m_sourceRows.size(); i++) {
+            sourceRows[m_sourceRows.at(i)] = i;
+        }
+        m_combatWidget->addJournalOperation(TableJournal::createOrderOperation(sourceRows));
+        return;
+    }
+
+    TableJournal::Operation operation;
+    if (!m_affectedRows.empty()) {
+        const auto& biggerTableData = m_oldData.tableData.size() > m_newData.tableData.size() ? m_oldData.tableData : m_newData.tableData;
+        // Same order as for the table widget, so every index is valid when it is applied
+        if (addRow) {
+            operation.type = TableJournal::Operation::Type::INSERT;
+            for (const auto row : m_affectedRows) {
+                operation.row = row;
+                operation.character = biggerTableData.at(row);
+                m_combatWidget->addJournalOperation(operation);
             }
+            return;
+        }
+        operation.type = TableJournal::Operation::Type::REMOVE;
+        for (auto it = m_affectedRows.rbegin(); it != m_affectedRows.rend(); ++it) {
+            operation.row = *it;
+            m_combatWidget->addJournalOperation(operation);
         }
-        affectedRows.erase(affectedRows.begin());
+        return;
+    }
+
+    operation.type = TableJournal::Operation::Type::SET;
+    for (const auto row : m_changedRows) {
+        operation.row = row;
+        operation.character = undo ? m_oldData.tableData.at(row) : m_newData.tableData.at(row);
+        m_combatWidget->addJournalOperation(operation);
     }
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "CharacterHandler.hpp"
+#include "TableJournal.hpp"
+
 #include <QPointer>
 #include <QUndoCommand>
 
@@ -13,9 +16,9 @@ class Undo : public QUndoCommand
 {
 public:
     struct UndoData {
-        const QVector<QVector<QVariant> > tableData{};
-        const unsigned int                rowEntered{ 0 };
-        const unsigned int                roundCounter{ 0 };
+        const QVector<CharacterHandler::Character> tableData{};
+        const unsigned int                         rowEntered{ 0 };
+        const unsigned int                         roundCounter{ 0 };
     };
 
 public:
@@ -25,6 +28,8 @@ public:
          const UndoData&        oldData,
          const UndoData&        newData,
          const std::vector<int> affectedRows,
+         const std::vector<int> changedRows,
+         const QVector<int>     sourceRows,
          unsigned int*          rowEntered,
          unsigned int*          roundCounter,
          bool                   colorTableRows,
@@ -41,13 +46,23 @@ private:
     setCombatWidget(bool undo);
 
     void
-    fillTableWidgetCell(const QVariant& data,
-                        int             row,
-                        int             col);
+    fillTableWidgetCell(const CharacterHandler::Character& character,
+                        int                                row,
+                        int                                col);
+
+    [[nodiscard]] static bool
+    isCellEqual(const CharacterHandler::Character& first,
+                const CharacterHandler::Character& second,
+                int                                col);
 
     void
     adjustTableWidgetRowCount(bool addRow);
 
+    // Report the applied rows to the autosave journal
+    void
+    addJournalOperations(bool undo,
+                         bool addRow);
+
 private:
     QPointer<CombatWidget> m_combatWidget;
 
@@ -57,7 +72,12 @@ private:
     const UndoData m_oldData;
     const UndoData m_newData;
 
+    // Ascending indices of the added or removed rows in the bigger table
     const std::vector<int> m_affectedRows;
+    // Rows with different content, if no rows have been added or removed
+    const std::vector<int> m_changedRows;
+    // Old index of every row, if the rows have only been reordered
+    const QVector<int> m_sourceRows;
 
     unsigned int *m_rowEntered;
     unsigned int *m_roundCounter;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QMetaType>
 #include <QVariant>
 
@@ -16,10 +17,64 @@ struct AdditionalInfoData {
             duration(std::move(duration))
         {
         }
+
+        [[nodiscard]] bool
+        operator==(const StatusEffect& other) const
+        {
+            return duration == other.duration && isPermanent == other.isPermanent && name == other.name;
+        }
+
+        [[nodiscard]] bool
+        operator!=(const StatusEffect& other) const
+        {
+            return !(*this == other);
+        }
     };
 
     QVector<StatusEffect> statusEffects;
     QString               mainInfoText;
+
+    [[nodiscard]] bool
+    operator==(const AdditionalInfoData& other) const
+    {
+        return statusEffects == other.statusEffects && mainInfoText == other.mainInfoText;
+    }
+
+    [[nodiscard]] bool
+    operator!=(const AdditionalInfoData& other) const
+    {
+        return !(*this == other);
+    }
 };
 
+// The hash value type differs between Qt 5 and 6
+using HashValue = decltype(qHash(0));
+
+// Mix a value into a hash, so equal fields in different positions do not cancel each other out
+[[nodiscard]] inline HashValue
+combineHash(HashValue seed, HashValue hash)
+{
+    return seed ^ (hash + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+
+[[nodiscard]] inline HashValue
+qHash(const AdditionalInfoData::StatusEffect& statusEffect, HashValue seed = 0)
+{
+    seed = combineHash(seed, qHash(statusEffect.name));
+    seed = combineHash(seed, qHash(statusEffect.isPermanent));
+    return combineHash(seed, qHash(statusEffect.duration));
+}
+
+
+[[nodiscard]] inline HashValue
+qHash(const AdditionalInfoData& additionalInfoData, HashValue seed = 0)
+{
+    seed = combineHash(seed, qHash(additionalInfoData.mainInfoText));
+    for (const auto& statusEffect : additionalInfoData.statusEffects) {
+        seed = combineHash(seed, qHash(statusEffect));
+    }
+    return seed;
+}
+
 Q_DECLARE_METATYPE(AdditionalInfoData);
@@ -1,12 +1,10 @@
 #include "AdditionalInfoWidget.hpp"
 
-#include "StatusEffectButton.hpp"
+#include "StatusEffectsWidget.hpp"
 #include "UtilsGeneral.hpp"
 
 #include <QApplication>
 #include <QEvent>
-#include <QHBoxLayout>
-#include <QLabel>
 #include <QVBoxLayout>
 
 AdditionalInfoWidget::AdditionalInfoWidget()
@@ -14,16 +12,12 @@ AdditionalInfoWidget::AdditionalInfoWidget()
     m_additionalInfoLineEdit = new FocusOutLineEdit;
     m_additionalInfoLineEdit->installEventFilter(this);
 
-    m_statusEffectLabel = new QLabel(tr("Status Effects:"));
-    m_statusEffectLabel->setVisible(false);
-
-    m_statusEffectsLayout = new QHBoxLayout;
-    m_statusEffectsLayout->addWidget(m_statusEffectLabel);
-    m_statusEffectsLayout->addSpacing(SPACING);
+    // A single widget paints all effects, regardless of their number
+    m_statusEffectsWidget = new StatusEffectsWidget;
 
     auto* const mainLayout = new QVBoxLayout;
     mainLayout->addWidget(m_additionalInfoLineEdit);
-    mainLayout->addLayout(m_statusEffectsLayout);
+    mainLayout->addWidget(m_statusEffectsWidget);
     mainLayout->setSpacing(BORDER_VALUES);
     mainLayout->setContentsMargins(BORDER_VALUES, BORDER_VALUES, BORDER_VALUES, BORDER_VALUES);
 
@@ -34,6 +28,20 @@ AdditionalInfoWidget::AdditionalInfoWidget()
         m_additionalInfoLineEdit->clearFocus();
     });
     connect(m_additionalInfoLineEdit, &FocusOutLineEdit::focusOut, this, &AdditionalInfoWidget::triggerAdditionalInfoEdited);
+
+    connect(m_statusEffectsWidget, &StatusEffectsWidget::menuCalled, this, [this] {
+        emit widgetCalled();
+    });
+    connect(m_statusEffectsWidget, &StatusEffectsWidget::effectChanged, this, [this] (int index, auto statusEffect) {
+        m_additionalInfoData.statusEffects[index] = statusEffect;
+        m_statusEffectsWidget->setStatusEffects(m_additionalInfoData.statusEffects);
+        emit additionalInfoEdited();
+    });
+    connect(m_statusEffectsWidget, &StatusEffectsWidget::removeCalled, this, [this] (int index) {
+        m_additionalInfoData.statusEffects.erase(m_additionalInfoData.statusEffects.begin() + index);
+        m_statusEffectsWidget->setStatusEffects(m_additionalInfoData.statusEffects);
+        emit additionalInfoEdited();
+    });
 }
 
 
@@ -53,6 +61,7 @@ AdditionalInfoWidget::adjustEffectDuration(bool decrease)
             statusEffects.erase(statusEffects.begin() + i);
         }
     }
+    m_statusEffectsWidget->setStatusEffects(statusEffects);
 }
 
 
@@ -60,36 +69,20 @@ void
 AdditionalInfoWidget::setStatusEffects(const QVector<AdditionalInfoData::StatusEffect>& effects)
 {
     m_additionalInfoData.statusEffects = effects;
-    m_statusEffectLabel->setVisible(!effects.empty());
-
-    m_statusEffectsLayoutWidth = 0;
-    m_statusEffectsLayoutWidth += Utils::General::getStringWidth(m_statusEffectLabel->text());
-
-    for (auto i = 0; i < m_additionalInfoData.statusEffects.size(); i++) {
-        auto* const statusEffectButton = new StatusEffectButton(m_additionalInfoData.statusEffects[i]);
-        connect(statusEffectButton, &StatusEffectButton::menuCalled, this, [this] {
-            emit widgetCalled();
-        });
-        connect(statusEffectButton, &StatusEffectButton::effectChanged, this, [this, i] (auto statusEffect) {
-            m_additionalInfoData.statusEffects[i] = statusEffect;
-            emit additionalInfoEdited();
-        });
-        connect(statusEffectButton, &StatusEffectButton::removeCalled, this, [this, i] {
-            m_additionalInfoData.statusEffects.erase(m_additionalInfoData.statusEffects.begin() + i);
-            emit additionalInfoEdited();
-        });
-
-        m_statusEffectsLayout->addWidget(statusEffectButton);
-        const auto buttonTextStringWidth = Utils::General::getStringWidth(statusEffectButton->text());
-        // The normal widget width returns weird values, so as a workaround use the text width with a buffer
-        m_statusEffectsLayoutWidth += buttonTextStringWidth + LENGTH_BUFFER;
-    }
-    m_statusEffectsLayout->addStretch();
+    m_statusEffectsWidget->setStatusEffects(effects);
 
     calculateWidth();
 }
 
 
+int
+AdditionalInfoWidget::getWidth() const
+{
+    const auto addInfoWidth = Utils::General::getStringWidth(m_additionalInfoLineEdit->text());
+    return std::max(addInfoWidth, m_statusEffectsWidget->getWidth());
+}
+
+
 void
 AdditionalInfoWidget::triggerAdditionalInfoEdited()
 {
@@ -106,10 +99,7 @@ AdditionalInfoWidget::triggerAdditionalInfoEdited()
 void
 AdditionalInfoWidget::calculateWidth()
 {
-    const auto addInfoNewWidth = Utils::General::getStringWidth(m_additionalInfoLineEdit->text());
-    const auto newWidgetWidth = std::max(addInfoNewWidth, m_statusEffectsLayoutWidth);
-
-    emit widthAdjusted(newWidgetWidth);
+    emit widthAdjusted(getWidth());
 }
 
 
@@ -6,8 +6,7 @@
 #include <QLineEdit>
 #include <QPointer>
 
-class QHBoxLayout;
-class QLabel;
+class StatusEffectsWidget;
 
 // This class displays additional information and status effects
 class AdditionalInfoWidget : public QWidget {
@@ -35,6 +34,10 @@ public:
         return m_additionalInfoLineEdit->text();
     }
 
+    // Width needed to show the main info text and all status effects
+    [[nodiscard]] int
+    getWidth() const;
+
     [[nodiscard]] const AdditionalInfoData
     getAdditionalInformation()
     {
@@ -68,16 +71,11 @@ private:
 
 private:
     QPointer<FocusOutLineEdit> m_additionalInfoLineEdit;
-    QPointer<QLabel> m_statusEffectLabel;
-    QPointer<QHBoxLayout> m_statusEffectsLayout;
+    QPointer<StatusEffectsWidget> m_statusEffectsWidget;
 
     AdditionalInfoData m_additionalInfoData;
 
     QString m_mainInfoTextCache;
 
-    int m_statusEffectsLayoutWidth = 0;
-
-    static constexpr int LENGTH_BUFFER = 30;
     static constexpr int BORDER_VALUES = 0;
-    static constexpr int SPACING = 10;
 };
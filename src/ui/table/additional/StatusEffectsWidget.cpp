@@ -0,0 +1,243 @@
+#include "StatusEffectsWidget.hpp"
+
+#include <QEvent>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QStyleOptionButton>
+#include <QStylePainter>
+
+namespace
+{
+QPoint
+getMousePosition(const QMouseEvent *event)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return event->position().toPoint();
+#else
+    return event->pos();
+#endif
+}
+}
+
+StatusEffectsWidget::StatusEffectsWidget(QWidget *parent) :
+    QWidget(parent),
+    m_labelText(tr("Status Effects:"))
+{
+    setMouseTracking(true);
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
+    setVisible(false);
+}
+
+
+void
+StatusEffectsWidget::setStatusEffects(const QVector<AdditionalInfoData::StatusEffect>& effects)
+{
+    m_statusEffects = effects;
+    m_hoveredIndex = -1;
+    setVisible(!m_statusEffects.empty());
+
+    calculateChipRects();
+    updateGeometry();
+    update();
+}
+
+
+int
+StatusEffectsWidget::getChipIndexAt(const QPoint& pos) const
+{
+    for (auto i = 0; i < m_chipRects.size(); i++) {
+        if (m_chipRects.at(i).contains(pos)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+QSize
+StatusEffectsWidget::sizeHint() const
+{
+    return QSize(m_width, m_height);
+}
+
+
+QSize
+StatusEffectsWidget::minimumSizeHint() const
+{
+    return QSize(0, m_height);
+}
+
+
+QString
+StatusEffectsWidget::getChipText(const AdditionalInfoData::StatusEffect& effect)
+{
+    auto text = effect.name;
+    if (!effect.isPermanent) {
+        text.append(" (" + QString::number(effect.duration) + ")");
+    }
+    return text;
+}
+
+
+void
+StatusEffectsWidget::paintEvent(QPaintEvent *)
+{
+    QStylePainter painter(this);
+
+    const QRect labelRect(0, 0, fontMetrics().horizontalAdvance(m_labelText), m_height);
+    painter.drawItemText(labelRect, Qt::AlignLeft | Qt::AlignVCenter, palette(), isEnabled(), m_labelText, QPalette::WindowText);
+
+    // Every chip is drawn like the push button it replaces
+    for (auto i = 0; i < m_statusEffects.size(); i++) {
+        QStyleOptionButton option;
+        option.initFrom(this);
+        option.rect = m_chipRects.at(i);
+        option.text = getChipText(m_statusEffects.at(i));
+        option.features = QStyleOptionButton::HasMenu;
+        option.state &= ~(QStyle::State_MouseOver | QStyle::State_HasFocus);
+        option.state |= QStyle::State_Raised;
+        if (i == m_hoveredIndex) {
+            option.state |= QStyle::State_MouseOver;
+        }
+        if (i == m_pressedIndex) {
+            option.state |= QStyle::State_Sunken;
+        }
+        painter.drawControl(QStyle::CE_PushButton, option);
+    }
+}
+
+
+void
+StatusEffectsWidget::mousePressEvent(QMouseEvent *event)
+{
+    const auto index = getChipIndexAt(getMousePosition(event));
+    if (event->button() != Qt::LeftButton || index < 0) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    openMenu(index);
+}
+
+
+void
+StatusEffectsWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (const auto index = getChipIndexAt(getMousePosition(event)); index != m_hoveredIndex) {
+        m_hoveredIndex = index;
+        update();
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+
+void
+StatusEffectsWidget::leaveEvent(QEvent *event)
+{
+    m_hoveredIndex = -1;
+    update();
+    QWidget::leaveEvent(event);
+}
+
+
+void
+StatusEffectsWidget::changeEvent(QEvent *event)
+{
+    // The chip sizes depend on font and style
+    if (event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange) {
+        calculateChipRects();
+        updateGeometry();
+    }
+    QWidget::changeEvent(event);
+}
+
+
+void
+StatusEffectsWidget::calculateChipRects()
+{
+    m_chipRects.clear();
+    m_chipRects.reserve(m_statusEffects.size());
+    if (m_statusEffects.empty()) {
+        m_width = 0;
+        m_height = 0;
+        return;
+    }
+
+    const auto metrics = fontMetrics();
+    auto x = metrics.horizontalAdvance(m_labelText) + SPACING;
+    m_height = 0;
+
+    for (const auto& effect : m_statusEffects) {
+        QStyleOptionButton option;
+        option.initFrom(this);
+        option.features = QStyleOptionButton::HasMenu;
+
+        const QSize contentSize(metrics.horizontalAdvance(getChipText(effect)) +
+                                style()->pixelMetric(QStyle::PM_MenuButtonIndicator, &option, this),
+                                metrics.height());
+        const auto chipSize = style()->sizeFromContents(QStyle::CT_PushButton, &option, contentSize, this);
+
+        m_chipRects.push_back(QRect(QPoint(x, 0), chipSize));
+        x += chipSize.width() + CHIP_SPACING;
+        m_height = std::max(m_height, chipSize.height());
+    }
+    m_width = x - CHIP_SPACING;
+
+    // Center the chips vertically if their heights differ
+    for (auto& chipRect : m_chipRects) {
+        chipRect.moveTop((m_height - chipRect.height()) / 2);
+    }
+}
+
+
+void
+StatusEffectsWidget::openMenu(int index)
+{
+    const auto statusEffect = m_statusEffects.at(index);
+
+    // Created on demand, so rows which are never clicked do not own any menu
+    QMenu menu(this);
+
+    if (!statusEffect.isPermanent) {
+        auto *const increaseMenu = menu.addMenu(tr("Add Rounds..."));
+        auto *const decreaseMenu = menu.addMenu(tr("Remove Rounds..."));
+
+        for (int i = 1; i < 4; i++) {
+            increaseMenu->addAction(QString::number(i), this, [this, index, i] {
+                changeDuration(index, i);
+            });
+            decreaseMenu->addAction(QString::number(i), this, [this, index, i] {
+                changeDuration(index, i * (-1));
+            });
+        }
+    }
+
+    menu.addAction(statusEffect.isPermanent ? tr("Make Temporary") : tr("Make Permanent"),
+                   this, [this, index, statusEffect] {
+        auto changedEffect = statusEffect;
+        changedEffect.isPermanent = !changedEffect.isPermanent;
+        emit effectChanged(index, changedEffect);
+    });
+    menu.addAction(tr("Remove"), this, [this, index] {
+        emit removeCalled(index);
+    });
+
+    emit menuCalled();
+
+    m_pressedIndex = index;
+    update();
+    menu.exec(mapToGlobal(m_chipRects.at(index).bottomLeft()));
+    m_pressedIndex = -1;
+    update();
+}
+
+
+void
+StatusEffectsWidget::changeDuration(int index, int value)
+{
+    auto statusEffect = m_statusEffects.at(index);
+    auto signedValue = (int) statusEffect.duration;
+    signedValue += value;
+    statusEffect.duration = std::max(signedValue, 1);
+
+    emit effectChanged(index, statusEffect);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "AdditionalInfoData.hpp"
+
+#include <QRect>
+#include <QVector>
+#include <QWidget>
+
+// This class paints all status effects of a character as a single strip of chips.
+// Clicks are hit-tested against the chips, the effect menu is only created when needed.
+class StatusEffectsWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit
+    StatusEffectsWidget(QWidget *parent = nullptr);
+
+    void
+    setStatusEffects(const QVector<AdditionalInfoData::StatusEffect>& effects);
+
+    // Index of the chip at the given position, -1 if there is none
+    [[nodiscard]] int
+    getChipIndexAt(const QPoint& pos) const;
+
+    [[nodiscard]] QRect
+    getChipRect(int index) const
+    {
+        return m_chipRects.at(index);
+    }
+
+    [[nodiscard]] int
+    getWidth() const
+    {
+        return m_width;
+    }
+
+    [[nodiscard]] QSize
+    sizeHint() const override;
+
+    [[nodiscard]] QSize
+    minimumSizeHint() const override;
+
+    [[nodiscard]] static QString
+    getChipText(const AdditionalInfoData::StatusEffect& effect);
+
+signals:
+    void
+    menuCalled();
+
+    void
+    effectChanged(int                              index,
+                  AdditionalInfoData::StatusEffect statusEffect);
+
+    void
+    removeCalled(int index);
+
+protected:
+    void
+    paintEvent(QPaintEvent *event) override;
+
+    void
+    mousePressEvent(QMouseEvent *event) override;
+
+    void
+    mouseMoveEvent(QMouseEvent *event) override;
+
+    void
+    leaveEvent(QEvent *event) override;
+
+    void
+    changeEvent(QEvent *event) override;
+
+private:
+    void
+    calculateChipRects();
+
+    void
+    openMenu(int index);
+
+    void
+    changeDuration(int index,
+                   int value);
+
+private:
+    QVector<AdditionalInfoData::StatusEffect> m_statusEffects;
+    QVector<QRect> m_chipRects;
+
+    QString m_labelText;
+
+    int m_width{ 0 };
+    int m_height{ 0 };
+
+    int m_hoveredIndex{ -1 };
+    int m_pressedIndex{ -1 };
+
+    static constexpr int SPACING = 10;
+    static constexpr int CHIP_SPACING = 6;
+};
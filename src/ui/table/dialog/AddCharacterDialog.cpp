@@ -58,7 +58,7 @@ AddCharacterDialog::AddCharacterDialog(const bool modAddedToIni, QWidget *parent
                                  "Status Effects are added in the main table widget."));
 
     m_instanceNumberBox = new QSpinBox;
-    m_instanceNumberBox->setRange(2, 10);
+    m_instanceNumberBox->setRange(2, 100);
     m_instanceNumberBox->setEnabled(false);
 
     m_multipleEnabledBox = new QCheckBox(tr("Add Character multiple Times:"));
@@ -67,6 +67,11 @@ AddCharacterDialog::AddCharacterDialog(const bool modAddedToIni, QWidget *parent
     m_multipleEnabledBox->setToolTip(tr("If this is selected and 'Save' is pressed,\n"
                                         "the Character is added multiple times to the Table."));
 
+    m_groupInstancesBox = new QCheckBox(tr("Add Instances as a single Group"));
+    m_groupInstancesBox->setEnabled(false);
+    m_groupInstancesBox->setToolTip(tr("If this is selected, the instances share a single row with\n"
+                                       "the HP of every instance. The Group can be expanded later on."));
+
     m_storeTemplatesButton = new QPushButton(tr("Store as Template"));
     m_storeTemplatesButton->setVisible(false);
     auto *const resetButton = new QPushButton(tr("Reset all entered Values"));
@@ -114,17 +119,19 @@ AddCharacterDialog::AddCharacterDialog(const bool modAddedToIni, QWidget *parent
     gridLayout->addWidget(m_multipleEnabledBox, 8, 0, 1, 3);
     gridLayout->addWidget(m_instanceNumberBox, 8, 3, 1, 1);
 
-    gridLayout->setRowMinimumHeight(9, MIN_ROW_HEIGHT);
+    gridLayout->addWidget(m_groupInstancesBox, 9, 0, 1, 4);
+
+    gridLayout->setRowMinimumHeight(10, MIN_ROW_HEIGHT);
 
-    gridLayout->addWidget(m_animatedLabel, 10, 0, 1, 2);
+    gridLayout->addWidget(m_animatedLabel, 11, 0, 1, 2);
 
-    gridLayout->addWidget(resetButton, 11, 2, 1, 2);
-    gridLayout->addWidget(m_storeTemplatesButton, 11, 0, 1, 2);
+    gridLayout->addWidget(resetButton, 12, 2, 1, 2);
+    gridLayout->addWidget(m_storeTemplatesButton, 12, 0, 1, 2);
 
-    gridLayout->setRowMinimumHeight(12, MIN_ROW_HEIGHT);
+    gridLayout->setRowMinimumHeight(13, MIN_ROW_HEIGHT);
 
-    gridLayout->addWidget(openTemplatesButton, 13, 0, 1, 1);
-    gridLayout->addWidget(buttonBox, 13, 1, 1, 3);
+    gridLayout->addWidget(openTemplatesButton, 14, 0, 1, 1);
+    gridLayout->addWidget(buttonBox, 14, 1, 1, 3);
 
     m_templatesWidget = new TemplatesWidget;
     m_templatesWidget->setVisible(false);
@@ -154,6 +161,7 @@ AddCharacterDialog::AddCharacterDialog(const bool modAddedToIni, QWidget *parent
     });
     connect(m_multipleEnabledBox, &QCheckBox::stateChanged, this, [this] {
         m_instanceNumberBox->setEnabled(m_multipleEnabledBox->checkState() == Qt::Checked);
+        m_groupInstancesBox->setEnabled(m_multipleEnabledBox->checkState() == Qt::Checked);
     });
 
     connect(m_storeTemplatesButton, &QPushButton::clicked, this, &AddCharacterDialog::storeTemplatesButtonClicked);
@@ -229,7 +237,13 @@ AddCharacterDialog::saveButtonClicked()
 
     CharacterHandler::Character character(m_nameEdit->text(), m_iniBox->value(), m_iniModifierBox->value(), m_hpBox->value(),
                                           m_enemyBox->isChecked(), additionalInfoData);
-    emit characterCreated(character, numberOfInstances);
+    // A group is a single character containing all instances
+    if (numberOfInstances > 1 && m_groupInstancesBox->isChecked()) {
+        character.setInstanceHp(QVector<int>(numberOfInstances, m_hpBox->value()));
+        emit characterCreated(character, 1);
+    } else {
+        emit characterCreated(character, numberOfInstances);
+    }
     resetButtonClicked();
     m_nameEdit->setFocus(Qt::TabFocusReason);
 
@@ -260,6 +274,7 @@ AddCharacterDialog::resetButtonClicked()
 
     m_multipleEnabledBox->setCheckState(Qt::Unchecked);
     m_instanceNumberBox->setValue(2);
+    m_groupInstancesBox->setChecked(false);
 }
 
 
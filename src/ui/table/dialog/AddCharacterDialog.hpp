@@ -60,6 +60,7 @@ private:
     QPointer<QLineEdit> m_addInfoEdit;
     QPointer<QCheckBox> m_multipleEnabledBox;
     QPointer<QSpinBox> m_instanceNumberBox;
+    QPointer<QCheckBox> m_groupInstancesBox;
     QPointer<QPushButton> m_storeTemplatesButton;
 
     QPointer<TemplatesWidget> m_templatesWidget;
@@ -1,13 +1,16 @@
 #include "ChangeHPDialog.hpp"
 
+#include <QComboBox>
 #include <QDialogButtonBox>
+#include <QFormLayout>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QPushButton>
+#include <QScrollArea>
 #include <QSpinBox>
 #include <QVBoxLayout>
 
-ChangeHPDialog::ChangeHPDialog(QWidget *parent) :
+ChangeHPDialog::ChangeHPDialog(const QStringList& names, QWidget *parent) :
     QDialog(parent)
 {
     setWindowTitle(tr("Change Character HP"));
@@ -21,18 +24,44 @@ ChangeHPDialog::ChangeHPDialog(QWidget *parent) :
     valueLayout->addWidget(valueLabel);
     valueLayout->addWidget(hpBox);
 
+    // Every character might be affected differently, for example if a saving throw succeeded
+    auto* const rulesWidget = new QWidget;
+    auto* const rulesLayout = new QFormLayout(rulesWidget);
+    QVector<QComboBox *> ruleBoxes;
+    for (const auto& name : names) {
+        auto* const ruleBox = new QComboBox;
+        ruleBox->addItem(tr("Full Value"), static_cast<int>(CharacterHandler::HpRule::FULL));
+        ruleBox->addItem(tr("Half Value (Save, Resistance)"), static_cast<int>(CharacterHandler::HpRule::HALF));
+        ruleBox->addItem(tr("Double Value (Vulnerability)"), static_cast<int>(CharacterHandler::HpRule::DOUBLE));
+        ruleBox->addItem(tr("No Change (Immunity)"), static_cast<int>(CharacterHandler::HpRule::NONE));
+
+        rulesLayout->addRow(name, ruleBox);
+        ruleBoxes.push_back(ruleBox);
+    }
+
+    auto* const rulesArea = new QScrollArea;
+    rulesArea->setWidget(rulesWidget);
+    rulesArea->setWidgetResizable(true);
+    rulesArea->setMaximumHeight(MAX_RULES_HEIGHT);
+
     auto *const buttonBox = new QDialogButtonBox;
     auto *const okButton = buttonBox->addButton(QDialogButtonBox::Ok);
     buttonBox->addButton(QDialogButtonBox::Cancel);
 
     auto* const mainLayout = new QVBoxLayout;
     mainLayout->addLayout(valueLayout);
+    mainLayout->addWidget(rulesArea);
     mainLayout->addWidget(buttonBox);
 
     setLayout(mainLayout);
 
-    connect(okButton, &QPushButton::clicked, this, [this, hpBox] {
+    connect(okButton, &QPushButton::clicked, this, [this, hpBox, ruleBoxes] {
         m_hpValue = hpBox->value();
+        m_hpRules.clear();
+        m_hpRules.reserve(ruleBoxes.size());
+        for (const auto* const ruleBox : ruleBoxes) {
+            m_hpRules.push_back(static_cast<CharacterHandler::HpRule>(ruleBox->currentData().toInt()));
+        }
         QDialog::accept();
     });
     connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "CharacterHandler.hpp"
+
 #include <QDialog>
 
 // Dialog used to add or subtract HP from multiple characters at once
@@ -8,7 +10,8 @@ class ChangeHPDialog : public QDialog {
 
 public:
     explicit
-    ChangeHPDialog(QWidget* parent = 0);
+    ChangeHPDialog(const QStringList& names,
+                   QWidget*           parent = 0);
 
     [[nodiscard]] int
     getHPValue()
@@ -16,6 +19,17 @@ public:
         return m_hpValue;
     }
 
+    // Rule for every character, in the order of the passed names
+    [[nodiscard]] QVector<CharacterHandler::HpRule>
+    getHpRules() const
+    {
+        return m_hpRules;
+    }
+
 private:
+    QVector<CharacterHandler::HpRule> m_hpRules;
+
     int m_hpValue = 0;
+
+    static constexpr int MAX_RULES_HEIGHT = 300;
 };
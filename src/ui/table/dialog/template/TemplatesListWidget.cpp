@@ -7,37 +7,92 @@ TemplatesListWidget::TemplatesListWidget(QWidget* parent) :
     setSelectionMode(QAbstractItemView::SingleSelection);
 
     setFocusPolicy(Qt::ClickFocus);
+    // Templates are added in no particular order
+    setSortingEnabled(true);
 }
 
 
 bool
 TemplatesListWidget::addCharacter(const CharacterHandler::Character& character)
 {
-    for (auto i = 0; i < count(); i++) {
-        const auto storedCharacter = item(i)->data(Qt::UserRole).value<CharacterHandler::Character>();
-        if (storedCharacter.name == character.name) {
-            return false;
-        }
+    if (m_itemsByName.contains(character.name)) {
+        return false;
     }
 
     auto *const item = new QListWidgetItem;
     item->setText(character.name);
     item->setData(Qt::UserRole, QVariant::fromValue(character));
     addItem(item);
+    m_itemsByName.insert(character.name, item);
     return true;
 }
 
 
+void
+TemplatesListWidget::addCharacters(const QVector<CharacterHandler::Character>& characters)
+{
+    if (characters.isEmpty()) {
+        return;
+    }
+
+    setUpdatesEnabled(false);
+    for (const auto& character : characters) {
+        addCharacter(character);
+    }
+    setUpdatesEnabled(true);
+}
+
+
+void
+TemplatesListWidget::updateCharacter(const CharacterHandler::Character& character)
+{
+    if (auto *const item = m_itemsByName.value(character.name); item) {
+        item->setData(Qt::UserRole, QVariant::fromValue(character));
+        return;
+    }
+    addCharacter(character);
+}
+
+
+void
+TemplatesListWidget::updateCharacters(const QVector<CharacterHandler::Character>& characters)
+{
+    if (characters.isEmpty()) {
+        return;
+    }
+
+    setUpdatesEnabled(false);
+    for (const auto& character : characters) {
+        updateCharacter(character);
+    }
+    setUpdatesEnabled(true);
+}
+
+
+void
+TemplatesListWidget::setCharacters(const QVector<CharacterHandler::Character>& characters)
+{
+    clear();
+    m_itemsByName.clear();
+    addCharacters(characters);
+}
+
+
 bool
 TemplatesListWidget::removeCharacter(const CharacterHandler::Character &character)
 {
-    for (auto i = 0; i < count(); i++) {
-        auto const storedCharacter = item(i)->data(Qt::UserRole).value<CharacterHandler::Character>();
-        if (storedCharacter.name == character.name) {
-            QListWidgetItem *it = this->takeItem(i);
-            delete it;
-            return true;
-        }
+    return removeCharacter(character.name);
+}
+
+
+bool
+TemplatesListWidget::removeCharacter(const QString& name)
+{
+    auto *const item = m_itemsByName.take(name);
+    if (!item) {
+        return false;
     }
-    return false;
+    // Deleting the item removes it from the list
+    delete item;
+    return true;
 }
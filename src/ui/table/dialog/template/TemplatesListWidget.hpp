@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QListWidget>
 
 #include "CharacterHandler.hpp"
@@ -15,6 +16,28 @@ public:
     bool
     addCharacter(const CharacterHandler::Character& character);
 
+    // Add multiple Characters, updating the list only once
+    void
+    addCharacters(const QVector<CharacterHandler::Character>& characters);
+
+    // Add a Character or replace the stored one with the same name
+    void
+    updateCharacter(const CharacterHandler::Character& character);
+
+    void
+    updateCharacters(const QVector<CharacterHandler::Character>& characters);
+
+    // Replace all Characters, keeping the given order if sorting is disabled
+    void
+    setCharacters(const QVector<CharacterHandler::Character>& characters);
+
     bool
     removeCharacter(const CharacterHandler::Character& character);
+
+    bool
+    removeCharacter(const QString& name);
+
+private:
+    // Character names mapped to their items, so no item data has to be decoded for a lookup
+    QHash<QString, QListWidgetItem*> m_itemsByName;
 };
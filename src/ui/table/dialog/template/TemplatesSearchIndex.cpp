@@ -0,0 +1,253 @@
+#include "TemplatesSearchIndex.hpp"
+
+#include <QPair>
+#include <QRegularExpression>
+#include <QtAlgorithms>
+
+#include <algorithm>
+
+void
+TemplatesSearchIndex::insert(const CharacterHandler::Character& character)
+{
+    static const QRegularExpression wordSeparator("[^\\w]+", QRegularExpression::UseUnicodePropertiesOption);
+
+    Entry entry;
+    entry.character = character;
+    entry.foldedName = character.name.toCaseFolded();
+    entry.foldedWords = entry.foldedName.split(wordSeparator, Qt::SkipEmptyParts);
+    entry.letterMask = getLetterMask(entry.foldedName);
+
+    if (const auto it = m_indices.constFind(character.name); it != m_indices.constEnd()) {
+        m_entries[*it] = entry;
+        return;
+    }
+    m_indices.insert(character.name, m_entries.size());
+    m_entries.push_back(entry);
+}
+
+
+void
+TemplatesSearchIndex::remove(const QString& name)
+{
+    const auto it = m_indices.constFind(name);
+    if (it == m_indices.constEnd()) {
+        return;
+    }
+
+    // Move the last entry into the gap, so nothing else has to be shifted
+    const auto index = *it;
+    m_indices.erase(it);
+    if (index != m_entries.size() - 1) {
+        m_entries[index] = m_entries.last();
+        m_indices[m_entries[index].character.name] = index;
+    }
+    m_entries.removeLast();
+}
+
+
+void
+TemplatesSearchIndex::clear()
+{
+    m_entries.clear();
+    m_indices.clear();
+}
+
+
+QVector<CharacterHandler::Character>
+TemplatesSearchIndex::search(const QString& queryString, int maxResults) const
+{
+    const auto query = parseQuery(queryString);
+
+    QVector<quint32> termMasks;
+    for (const auto& term : query.terms) {
+        termMasks.push_back(getLetterMask(term));
+    }
+
+    // Pairs of score and entry index
+    QVector<QPair<int, int> > scores;
+    for (auto i = 0; i < m_entries.size(); i++) {
+        const auto& entry = m_entries.at(i);
+        if (!matchesFilters(query, entry)) {
+            continue;
+        }
+
+        // Every term has to match
+        auto score = 0;
+        for (auto j = 0; j < query.terms.size(); j++) {
+            const auto termScore = scoreTerm(query.terms.at(j), termMasks.at(j), entry);
+            if (termScore == 0) {
+                score = 0;
+                break;
+            }
+            score += termScore;
+        }
+        if (score > 0 || query.terms.isEmpty()) {
+            scores.push_back({ score, i });
+        }
+    }
+
+    // Best score first, equal scores are sorted by name
+    const auto resultCount = std::min<int>(maxResults, scores.size());
+    std::partial_sort(scores.begin(), scores.begin() + resultCount, scores.end(), [this] (const auto& first, const auto& second) {
+        if (first.first != second.first) {
+            return first.first > second.first;
+        }
+        return m_entries.at(first.second).foldedName < m_entries.at(second.second).foldedName;
+    });
+
+    QVector<CharacterHandler::Character> results;
+    results.reserve(resultCount);
+    for (auto i = 0; i < resultCount; i++) {
+        results.push_back(m_entries.at(scores.at(i).second).character);
+    }
+    return results;
+}
+
+
+TemplatesSearchIndex::Query
+TemplatesSearchIndex::parseQuery(const QString& queryString)
+{
+    static const QRegularExpression filterExpression("^(hp|mod)(<=|>=|<|>|=)(-?\\d+)$");
+
+    Query query;
+    const auto tokens = queryString.toCaseFolded().split(' ', Qt::SkipEmptyParts);
+    for (const auto& token : tokens) {
+        if (token == "is:enemy" || token == "is:ally") {
+            query.isEnemy = token == "is:enemy";
+            continue;
+        }
+
+        const auto match = filterExpression.match(token);
+        if (!match.hasMatch()) {
+            query.terms.push_back(token);
+            continue;
+        }
+
+        auto& minValue = match.captured(1) == "hp" ? query.minHP : query.minModifier;
+        auto& maxValue = match.captured(1) == "hp" ? query.maxHP : query.maxModifier;
+        const auto comparison = match.captured(2);
+        const auto value = match.captured(3).toInt();
+        if (comparison == "<") {
+            maxValue = std::min(maxValue, value - 1);
+        } else if (comparison == "<=") {
+            maxValue = std::min(maxValue, value);
+        } else if (comparison == ">") {
+            minValue = std::max(minValue, value + 1);
+        } else if (comparison == ">=") {
+            minValue = std::max(minValue, value);
+        } else {
+            minValue = std::max(minValue, value);
+            maxValue = std::min(maxValue, value);
+        }
+    }
+    return query;
+}
+
+
+bool
+TemplatesSearchIndex::matchesFilters(const Query& query, const Entry& entry)
+{
+    const auto& character = entry.character;
+    return character.hp >= query.minHP && character.hp <= query.maxHP &&
+           character.modifier >= query.minModifier && character.modifier <= query.maxModifier &&
+           (query.isEnemy == -1 || character.isEnemy == (bool) query.isEnemy);
+}
+
+
+int
+TemplatesSearchIndex::scoreTerm(const QString& term, quint32 termMask, const Entry& entry)
+{
+    const auto& name = entry.foldedName;
+    if (name == term) {
+        return SCORE_EXACT;
+    }
+    // Shorter names and earlier matches rank higher
+    if (name.startsWith(term)) {
+        return SCORE_PREFIX - std::min<int>(name.size() - term.size(), MAX_PENALTY);
+    }
+    for (const auto& word : entry.foldedWords) {
+        if (word.startsWith(term)) {
+            return SCORE_WORD_PREFIX - std::min<int>(name.size() - term.size(), MAX_PENALTY);
+        }
+    }
+    if (const auto position = name.indexOf(term); position != -1) {
+        return SCORE_SUBSTRING - std::min<int>(position, MAX_PENALTY);
+    }
+
+    // Allow one typo for medium and two for long terms. Every letter missing in the name needs at least
+    // one edit, so most names are skipped without computing a single distance
+    const auto maxDistance = term.size() < 4 ? 0 : term.size() < 8 ? 1 : 2;
+    if (maxDistance > 0 && (int) qPopulationCount(termMask & ~entry.letterMask) <= maxDistance) {
+        auto distance = getEditDistance(term, name.left(term.size()), maxDistance);
+        for (const auto& word : entry.foldedWords) {
+            distance = std::min(distance, getEditDistance(term, word, maxDistance));
+        }
+        if (distance <= maxDistance) {
+            return SCORE_TYPO - distance * 100 / (maxDistance + 1);
+        }
+    }
+
+    // Abbreviations like "gbln" for "goblin"
+    auto namePosition = 0;
+    auto gaps = 0;
+    for (const auto& character : term) {
+        const auto position = name.indexOf(character, namePosition);
+        if (position == -1) {
+            return 0;
+        }
+        gaps += position - namePosition;
+        namePosition = position + 1;
+    }
+    return SCORE_SUBSEQUENCE - std::min(gaps, MAX_PENALTY);
+}
+
+
+int
+TemplatesSearchIndex::getEditDistance(const QString& first, const QString& second, int maxDistance)
+{
+    if (std::abs(first.size() - second.size()) > maxDistance) {
+        return maxDistance + 1;
+    }
+
+    // Three rows are needed to detect swapped neighbours
+    QVector<int> previousRow(second.size() + 1);
+    QVector<int> row(second.size() + 1);
+    QVector<int> nextRow(second.size() + 1);
+    for (auto j = 0; j <= second.size(); j++) {
+        row[j] = j;
+    }
+
+    for (auto i = 1; i <= first.size(); i++) {
+        nextRow[0] = i;
+        auto rowMinimum = i;
+        for (auto j = 1; j <= second.size(); j++) {
+            const auto cost = first.at(i - 1) == second.at(j - 1) ? 0 : 1;
+            nextRow[j] = std::min({ row[j] + 1, nextRow[j - 1] + 1, row[j - 1] + cost });
+            if (i > 1 && j > 1 && first.at(i - 1) == second.at(j - 2) && first.at(i - 2) == second.at(j - 1)) {
+                nextRow[j] = std::min(nextRow[j], previousRow[j - 2] + 1);
+            }
+            rowMinimum = std::min(rowMinimum, nextRow[j]);
+        }
+        if (rowMinimum > maxDistance) {
+            return maxDistance + 1;
+        }
+        std::swap(previousRow, row);
+        std::swap(row, nextRow);
+    }
+    return row[second.size()];
+}
+
+
+quint32
+TemplatesSearchIndex::getLetterMask(const QString& string)
+{
+    quint32 letterMask = 0;
+    for (const auto& character : string) {
+        if (character >= 'a' && character <= 'z') {
+            letterMask |= 1u << (character.unicode() - 'a');
+        } else if (character.isDigit()) {
+            letterMask |= 1u << 26;
+        }
+    }
+    return letterMask;
+}
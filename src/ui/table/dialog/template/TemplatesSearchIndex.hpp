@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CharacterHandler.hpp"
+
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+#include <limits>
+
+// In-memory search over the templates. A query consists of search terms and optional filters, for example
+// "gobln hp>10 mod>=2 is:enemy". Terms are matched typo-tolerant against the names, results are ranked.
+class TemplatesSearchIndex {
+public:
+    // Add a Character or replace the stored one with the same name
+    void
+    insert(const CharacterHandler::Character& character);
+
+    void
+    remove(const QString& name);
+
+    void
+    clear();
+
+    [[nodiscard]] int
+    size() const
+    {
+        return m_entries.size();
+    }
+
+    // Return the best matching Characters, best match first
+    [[nodiscard]] QVector<CharacterHandler::Character>
+    search(const QString& queryString,
+           int            maxResults) const;
+
+private:
+    struct Entry {
+        CharacterHandler::Character character;
+        // Case folded name and its single words
+        QString                     foldedName;
+        QStringList                 foldedWords;
+        // Letters contained in the name, used to skip entries before comparing any strings
+        quint32                     letterMask;
+    };
+
+    struct Query {
+        QStringList terms;
+        int         minHP{ std::numeric_limits<int>::min() };
+        int         maxHP{ std::numeric_limits<int>::max() };
+        int         minModifier{ std::numeric_limits<int>::min() };
+        int         maxModifier{ std::numeric_limits<int>::max() };
+        // -1 if enemies and allies are both included
+        int         isEnemy{ -1 };
+    };
+
+    [[nodiscard]] static Query
+    parseQuery(const QString& queryString);
+
+    [[nodiscard]] static bool
+    matchesFilters(const Query& query,
+                   const Entry& entry);
+
+    // Score a single term, 0 if the term does not match at all
+    [[nodiscard]] static int
+    scoreTerm(const QString& term,
+              quint32        termMask,
+              const Entry&   entry);
+
+    // Edit distance counting swapped neighbours as a single edit. Stops as soon as the maximum is exceeded
+    [[nodiscard]] static int
+    getEditDistance(const QString& first,
+                    const QString& second,
+                    int            maxDistance);
+
+    [[nodiscard]] static quint32
+    getLetterMask(const QString& string);
+
+private:
+    QVector<Entry> m_entries;
+    // Names mapped to their position in the entries
+    QHash<QString, int> m_indices;
+
+    static constexpr int SCORE_EXACT = 1000;
+    static constexpr int SCORE_PREFIX = 900;
+    static constexpr int SCORE_WORD_PREFIX = 800;
+    static constexpr int SCORE_SUBSTRING = 700;
+    static constexpr int SCORE_TYPO = 500;
+    static constexpr int SCORE_SUBSEQUENCE = 300;
+    // Largest penalty within a single score tier, so tiers never overlap
+    static constexpr int MAX_PENALTY = 99;
+};
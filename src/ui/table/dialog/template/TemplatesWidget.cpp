@@ -1,26 +1,54 @@
 #include "TemplatesWidget.hpp"
 
-#include <QDirIterator>
 #include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
 #include <QGridLayout>
+#include <QLineEdit>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QSet>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentMap>
 
+#include "TemplateBundle.hpp"
 #include "UtilsGeneral.hpp"
+#include "UtilsTrace.hpp"
 
 TemplatesWidget::TemplatesWidget(QWidget* parent) :
     QWidget(parent)
 {
     m_charFileHandler = std::make_unique<CharFileHandler>();
+    m_templateIndex = std::make_unique<TemplateIndex>(m_charFileHandler->getDirectoryString());
 
     m_templatesListWidget = new TemplatesListWidget;
+    // Results are shown in their ranked order
+    m_searchResultsWidget = new TemplatesListWidget;
+    m_searchResultsWidget->setSortingEnabled(false);
+    m_searchResultsWidget->setVisible(false);
+
+    m_searchEdit = new QLineEdit;
+    m_searchEdit->setPlaceholderText(tr("Search, e.g. 'goblin hp>10 mod>=2 is:enemy'"));
+    m_searchEdit->setClearButtonEnabled(true);
+    m_searchEdit->setToolTip(tr("Names are matched even with typos. Filter with 'hp' and 'mod' combined with <, <=, =, >= or >,\n"
+                                "'is:enemy' and 'is:ally'."));
 
     auto* const templatesButtonBox = new QDialogButtonBox;
     auto *const applyTemplateButton = templatesButtonBox->addButton(QDialogButtonBox::Apply);
     auto* const removeTemplatesButton = templatesButtonBox->addButton(tr("Remove"), QDialogButtonBox::ActionRole);
+
+    auto* const bundleButtonBox = new QDialogButtonBox;
+    auto* const importTemplatesButton = bundleButtonBox->addButton(tr("Import..."), QDialogButtonBox::ActionRole);
+    importTemplatesButton->setToolTip(tr("Import the templates of a template bundle. Templates with the same name are replaced."));
+    auto* const exportTemplatesButton = bundleButtonBox->addButton(tr("Export..."), QDialogButtonBox::ActionRole);
+    exportTemplatesButton->setToolTip(tr("Export all templates into a single template bundle."));
     // Recreate sizes as if it was the main grid layout for creating a new Character
     auto* const layout = new QGridLayout;
-    layout->addWidget(m_templatesListWidget, 0, 0, 13, 3);
+    layout->addWidget(m_searchEdit, 0, 0, 1, 3);
+    layout->addWidget(m_templatesListWidget, 1, 0, 12, 3);
+    layout->addWidget(m_searchResultsWidget, 1, 0, 12, 3);
+    layout->addWidget(bundleButtonBox, 13, 0, 1, 1);
     layout->addWidget(templatesButtonBox, 13, 1, 1, 1);
     layout->addWidget(removeTemplatesButton, 13, 2, 1, 1);
     layout->setSpacing(0);
@@ -28,28 +56,65 @@ TemplatesWidget::TemplatesWidget(QWidget* parent) :
 
     setLayout(layout);
 
+    m_loadFutureWatcher = new QFutureWatcher<TemplateIndex::ParseResult>(this);
+    connect(m_loadFutureWatcher, &QFutureWatcher<TemplateIndex::ParseResult>::resultsReadyAt,
+            this, &TemplatesWidget::addParsedTemplates);
+    connect(m_loadFutureWatcher, &QFutureWatcher<TemplateIndex::ParseResult>::finished, this, [this] {
+        m_reparsedNames.clear();
+        if (!m_loadFutureWatcher->isCanceled() && m_templateIndex->isModified()) {
+            m_templateIndex->write();
+        }
+    });
+
+    // Editors and file managers often change multiple files at once, so collect them into a single refresh
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(REFRESH_DELAY);
+    connect(m_refreshTimer, &QTimer::timeout, this, &TemplatesWidget::refreshTemplates);
+
+    m_fileSystemWatcher = new QFileSystemWatcher(this);
+    connect(m_fileSystemWatcher, &QFileSystemWatcher::directoryChanged, m_refreshTimer, QOverload<>::of(&QTimer::start));
+
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &TemplatesWidget::searchTemplates);
     connect(applyTemplateButton, &QPushButton::clicked, this, &TemplatesWidget::applyButtonClicked);
     connect(removeTemplatesButton, &QPushButton::clicked, this, &TemplatesWidget::removeButtonClicked);
+    connect(importTemplatesButton, &QPushButton::clicked, this, &TemplatesWidget::importButtonClicked);
+    connect(exportTemplatesButton, &QPushButton::clicked, this, &TemplatesWidget::exportButtonClicked);
+}
+
+
+TemplatesWidget::~TemplatesWidget()
+{
+    m_loadFutureWatcher->cancel();
+    m_loadFutureWatcher->waitForFinished();
 }
 
 
 void
 TemplatesWidget::loadTemplates()
 {
-    QDirIterator it(m_charFileHandler->getDirectoryString(), { "*.char" }, QDir::Files);
-
-    while (it.hasNext()) {
-        it.next();
-        const auto fileName = it.fileName();
-
-        if (const auto code = m_charFileHandler->getStatus(fileName); code == 0) {
-            const auto characterObject = m_charFileHandler->getData();
-            CharacterHandler::Character character(characterObject["name"].toString(), characterObject["initiative"].toInt(),
-                                                  characterObject["modifier"].toInt(), characterObject["hp"].toInt(),
-                                                  characterObject["is_enemy"].toBool(),
-                                                  AdditionalInfoData{ {}, characterObject["additional_info"].toString() });
-            m_templatesListWidget->addCharacter(character);
-        }
+    TRACE_SCOPE("TemplatesWidget::loadTemplates");
+
+    if (m_loadFutureWatcher->isRunning()) {
+        return;
+    }
+
+    // Only templates changed since the last time are parsed again
+    const auto changedFiles = m_templateIndex->validate();
+
+    QVector<CharacterHandler::Character> characters;
+    characters.reserve(m_templateIndex->getEntries().size());
+    for (const auto& entry : m_templateIndex->getEntries()) {
+        characters.push_back(entry.character);
+    }
+    m_templatesListWidget->addCharacters(characters);
+    m_isSearchIndexOutdated = true;
+    templatesChanged();
+    parseTemplates(changedFiles);
+
+    // From now on, only single templates have to be updated
+    if (m_fileSystemWatcher->directories().isEmpty()) {
+        m_fileSystemWatcher->addPath(m_charFileHandler->getDirectoryString());
     }
 }
 
@@ -62,20 +127,138 @@ TemplatesWidget::addCharacter(const CharacterHandler::Character& character)
     }
     if (!m_charFileHandler->writeToFile(character)) {
         Utils::General::displayWarningMessageBox(this, tr("Action not possible!"), tr("The Character could not be saved!"));
+        return;
     }
+    m_templateIndex->insert(character.name + ".char", character);
+    m_templateIndex->write();
+    m_searchIndex.insert(character);
+    templatesChanged();
+}
+
+
+void
+TemplatesWidget::addParsedTemplates(int beginIndex, int endIndex)
+{
+    TRACE_SCOPE("TemplatesWidget::addParsedTemplates");
+
+    QVector<CharacterHandler::Character> characters;
+    for (auto i = beginIndex; i < endIndex; i++) {
+        const auto parseResult = m_loadFutureWatcher->resultAt(i);
+        // A changed template might have been renamed or broken
+        if (const auto reparsedName = m_reparsedNames.value(parseResult.fileName);
+            !reparsedName.isEmpty() && (!parseResult.isValid || reparsedName != parseResult.entry.character.name)) {
+            m_templatesListWidget->removeCharacter(reparsedName);
+            m_searchIndex.remove(reparsedName);
+        }
+        if (!parseResult.isValid) {
+            continue;
+        }
+        m_templateIndex->insert(parseResult);
+        m_searchIndex.insert(parseResult.entry.character);
+        characters.push_back(parseResult.entry.character);
+    }
+    m_templatesListWidget->updateCharacters(characters);
+    templatesChanged();
+}
+
+
+void
+TemplatesWidget::refreshTemplates()
+{
+    TRACE_SCOPE("TemplatesWidget::refreshTemplates");
+
+    // Try again once the current templates are parsed
+    if (m_loadFutureWatcher->isRunning()) {
+        m_refreshTimer->start();
+        return;
+    }
+
+    const auto oldEntries = m_templateIndex->getEntries();
+    const auto changedFiles = m_templateIndex->update();
+    const auto& entries = m_templateIndex->getEntries();
+
+    QSet<QString> changedFileNames;
+    for (const auto& changedFile : changedFiles) {
+        changedFileNames.insert(QFileInfo(changedFile).fileName());
+    }
+
+    // Unchanged templates stay as they are, removed ones are taken out of the list
+    for (auto it = oldEntries.constBegin(); it != oldEntries.constEnd(); ++it) {
+        if (entries.contains(it.key())) {
+            continue;
+        }
+        if (changedFileNames.contains(it.key())) {
+            m_reparsedNames.insert(it.key(), it->character.name);
+            continue;
+        }
+        m_templatesListWidget->removeCharacter(it->character.name);
+        m_searchIndex.remove(it->character.name);
+    }
+
+    templatesChanged();
+    parseTemplates(changedFiles);
+}
+
+
+void
+TemplatesWidget::searchTemplates()
+{
+    TRACE_SCOPE("TemplatesWidget::searchTemplates");
+
+    const auto queryString = m_searchEdit->text().trimmed();
+    const auto isSearching = !queryString.isEmpty();
+    m_templatesListWidget->setVisible(!isSearching);
+    m_searchResultsWidget->setVisible(isSearching);
+    if (!isSearching) {
+        return;
+    }
+
+    if (m_isSearchIndexOutdated) {
+        m_searchIndex.clear();
+        for (const auto& entry : m_templateIndex->getEntries()) {
+            m_searchIndex.insert(entry.character);
+        }
+        m_isSearchIndexOutdated = false;
+    }
+    m_searchResultsWidget->setCharacters(m_searchIndex.search(queryString, MAX_SEARCH_RESULTS));
+}
+
+
+void
+TemplatesWidget::parseTemplates(const QStringList& filePaths)
+{
+    // Every worker uses its own parser, so the files are parsed concurrently
+    m_loadFutureWatcher->setFuture(QtConcurrent::mapped(filePaths, &TemplateIndex::parseTemplate));
+}
+
+
+void
+TemplatesWidget::templatesChanged()
+{
+    if (getShownListWidget() == m_searchResultsWidget) {
+        searchTemplates();
+    }
+}
+
+
+TemplatesListWidget*
+TemplatesWidget::getShownListWidget() const
+{
+    return m_searchEdit->text().trimmed().isEmpty() ? m_templatesListWidget : m_searchResultsWidget;
 }
 
 
 void
 TemplatesWidget::applyButtonClicked()
 {
-    if (m_templatesListWidget->selectedItems().isEmpty()) {
+    auto *const listWidget = getShownListWidget();
+    if (listWidget->selectedItems().isEmpty()) {
         Utils::General::displayWarningMessageBox(this, tr("Action not possible!"),
                                                  tr("Please select a Character from the list to apply it to the current Character!"));
         return;
     }
 
-    const auto character = m_templatesListWidget->selectedItems().first()->data(Qt::UserRole).value<CharacterHandler::Character>();
+    const auto character = listWidget->selectedItems().first()->data(Qt::UserRole).value<CharacterHandler::Character>();
     emit characterLoaded(character);
 }
 
@@ -83,18 +266,69 @@ TemplatesWidget::applyButtonClicked()
 void
 TemplatesWidget::removeButtonClicked()
 {
-    if (m_templatesListWidget->selectedItems().isEmpty()) {
+    auto *const listWidget = getShownListWidget();
+    if (listWidget->selectedItems().isEmpty()) {
         Utils::General::displayWarningMessageBox(this, tr("Action not possible!"),
                                                  tr("Please select a Character from the list to remove the current Character!"));
         return;
     }
 
-    const auto character = m_templatesListWidget->selectedItems().first()->data(Qt::UserRole).value<CharacterHandler::Character>();
+    const auto character = listWidget->selectedItems().first()->data(Qt::UserRole).value<CharacterHandler::Character>();
     if (!m_templatesListWidget->removeCharacter(character)) {
         Utils::General::displayWarningMessageBox(this, tr("Action not possible!"), tr("Could not remove Character!"));
         return;
     }
     if (!m_charFileHandler->removeCharacter(character.name + ".char")) {
         Utils::General::displayWarningMessageBox(this, tr("Action not possible!"), tr("The Character could not be removed!"));
+        return;
+    }
+    m_templateIndex->remove(character.name + ".char");
+    m_templateIndex->write();
+    m_searchIndex.remove(character.name);
+    templatesChanged();
+}
+
+
+void
+TemplatesWidget::exportButtonClicked()
+{
+    const auto fileName = QFileDialog::getSaveFileName(this, tr("Export Templates"), "templates.lcmb",
+                                                       tr("Template Bundle (*.lcmb);;All Files (*)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QVector<CharacterHandler::Character> characters;
+    characters.reserve(m_templateIndex->getEntries().size());
+    for (const auto& entry : m_templateIndex->getEntries()) {
+        characters.push_back(entry.character);
+    }
+    // The bundle is written completely before an existing file is replaced
+    if (!TemplateBundle::writeBundle(fileName, characters)) {
+        Utils::General::displayWarningMessageBox(this, tr("Action not possible!"), tr("The Templates could not be exported!"));
+    }
+}
+
+
+void
+TemplatesWidget::importButtonClicked()
+{
+    const auto fileName = QFileDialog::getOpenFileName(this, tr("Import Templates"), "", tr("Template Bundle (*.lcmb)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    // Only read, so the chosen file is never modified
+    TemplateBundle templateBundle(fileName);
+    if (!templateBundle.open(true)) {
+        Utils::General::displayWarningMessageBox(this, tr("Action not possible!"), tr("The file is no valid Template Bundle!"));
+        return;
+    }
+
+    const auto templatesCount = templateBundle.getNames().size();
+    if (templateBundle.exportDirectory(m_charFileHandler->getDirectoryString()) < templatesCount) {
+        Utils::General::displayWarningMessageBox(this, tr("Action not possible!"), tr("Not all Templates could be imported!"));
     }
+    // Add the written templates without waiting for the file system watcher
+    refreshTemplates();
 }
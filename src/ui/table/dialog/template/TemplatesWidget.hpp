@@ -1,11 +1,19 @@
 #pragma once
 
+#include <QFutureWatcher>
+#include <QHash>
 #include <QPointer>
 #include <QWidget>
 
 #include "CharacterHandler.hpp"
 #include "CharFileHandler.hpp"
+#include "TemplateIndex.hpp"
 #include "TemplatesListWidget.hpp"
+#include "TemplatesSearchIndex.hpp"
+
+class QFileSystemWatcher;
+class QLineEdit;
+class QTimer;
 
 // Widget used to handle the templates
 class TemplatesWidget : public QWidget {
@@ -15,6 +23,10 @@ public:
     explicit
     TemplatesWidget(QWidget * parent = 0);
 
+    ~TemplatesWidget();
+
+    // Show all indexed templates at once, changed templates are parsed in the
+    // background and added to the list as soon as they are available
     void
     loadTemplates();
 
@@ -32,14 +44,64 @@ signals:
     characterLoaded(const CharacterHandler::Character& character);
 
 private slots:
+    void
+    addParsedTemplates(int beginIndex,
+                       int endIndex);
+
+    // Apply changes made to the template directory by other programs
+    void
+    refreshTemplates();
+
+    // Show the ranked search results instead of all templates
+    void
+    searchTemplates();
+
     void
     applyButtonClicked();
 
     void
     removeButtonClicked();
 
+    // Write all templates into a single bundle file, for example to share them
+    void
+    exportButtonClicked();
+
+    // Store the templates of a bundle file as loose templates
+    void
+    importButtonClicked();
+
+private:
+    void
+    parseTemplates(const QStringList& filePaths);
+
+    // Has to be called whenever templates are added, changed or removed, so the search results stay up to date
+    void
+    templatesChanged();
+
+    // Either the list of all templates or the search results
+    [[nodiscard]] TemplatesListWidget*
+    getShownListWidget() const;
+
 private:
     QPointer<TemplatesListWidget> m_templatesListWidget;
+    QPointer<TemplatesListWidget> m_searchResultsWidget;
+    QPointer<QLineEdit> m_searchEdit;
+
+    QPointer<QFutureWatcher<TemplateIndex::ParseResult> > m_loadFutureWatcher;
+
+    QPointer<QFileSystemWatcher> m_fileSystemWatcher;
+    QPointer<QTimer> m_refreshTimer;
 
     std::unique_ptr<CharFileHandler> m_charFileHandler;
+    std::unique_ptr<TemplateIndex> m_templateIndex;
+
+    // Rebuilt from the template index after a full reload, otherwise updated along with the list
+    TemplatesSearchIndex m_searchIndex;
+    bool m_isSearchIndexOutdated{ true };
+
+    // Names of changed templates which are parsed again, stored by file name
+    QHash<QString, QString> m_reparsedNames;
+
+    static constexpr int REFRESH_DELAY = 250;
+    static constexpr int MAX_SEARCH_RESULTS = 200;
 };
@@ -0,0 +1,146 @@
+#include "IconCache.hpp"
+
+#include <QApplication>
+#include <QDirIterator>
+#include <QPainter>
+#include <QPixmap>
+#include <QSvgRenderer>
+#include <QtConcurrent/QtConcurrentRun>
+
+IconCache&
+IconCache::instance()
+{
+    static IconCache iconCache;
+    return iconCache;
+}
+
+
+IconCache::IconCache()
+{
+    connect(&m_preloadWatcher, &QFutureWatcher<RasterizedIcons>::finished, this, &IconCache::insertPreloadedIcons);
+    // The pixmaps must not outlive the application
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &IconCache::clear);
+}
+
+
+void
+IconCache::preload(const QStringList& fileNames, qreal devicePixelRatio)
+{
+    waitForPreload();
+
+    // Only images may be painted outside of the main thread, the pixmaps are created afterwards
+    m_preloadWatcher.setFuture(QtConcurrent::run([fileNames, devicePixelRatio] {
+        RasterizedIcons rasterizedIcons;
+        for (const auto& fileName : fileNames) {
+            rasterizedIcons[IconKey(fileName, devicePixelRatio)] = rasterize(fileName, devicePixelRatio);
+        }
+        return rasterizedIcons;
+    }));
+}
+
+
+void
+IconCache::waitForPreload()
+{
+    m_preloadWatcher.waitForFinished();
+    insertPreloadedIcons();
+}
+
+
+QIcon
+IconCache::getIcon(const QString& fileName)
+{
+    const IconKey iconKey(fileName, qApp->devicePixelRatio());
+    if (const auto it = m_icons.constFind(iconKey); it != m_icons.constEnd()) {
+        return *it;
+    }
+
+    // Use a finished preload, but do not wait for a running one. Only the requested icon is rasterized then
+    insertPreloadedIcons();
+    if (const auto it = m_icons.constFind(iconKey); it != m_icons.constEnd()) {
+        return *it;
+    }
+
+    const auto icon = createIcon(rasterize(iconKey.first, iconKey.second));
+    m_icons.insert(iconKey, icon);
+    return icon;
+}
+
+
+void
+IconCache::clear()
+{
+    waitForPreload();
+    m_icons.clear();
+}
+
+
+QStringList
+IconCache::getResourceIconFileNames()
+{
+    QStringList fileNames;
+    QDirIterator it(":/icons", { "*.svg" }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        fileNames.push_back(it.next());
+    }
+    return fileNames;
+}
+
+
+void
+IconCache::insertPreloadedIcons()
+{
+    if (!m_preloadWatcher.isFinished() || m_preloadWatcher.future().resultCount() == 0) {
+        return;
+    }
+
+    const auto rasterizedIcons = m_preloadWatcher.result();
+    for (auto it = rasterizedIcons.constBegin(); it != rasterizedIcons.constEnd(); ++it) {
+        if (!m_icons.contains(it.key())) {
+            m_icons.insert(it.key(), createIcon(it.value()));
+        }
+    }
+    // Do not insert the same results again
+    m_preloadWatcher.setFuture(QFuture<RasterizedIcons>());
+}
+
+
+QVector<QImage>
+IconCache::rasterize(const QString& fileName, qreal devicePixelRatio)
+{
+    QVector<QImage> images;
+    QSvgRenderer svgRenderer(fileName);
+    if (!svgRenderer.isValid()) {
+        return images;
+    }
+
+    for (const auto iconSize : ICON_SIZES) {
+        const auto pixelSize = qRound(iconSize * devicePixelRatio);
+        QImage image(pixelSize, pixelSize, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+
+        // Keep the aspect ratio of non square logos
+        const auto targetSize = QSizeF(svgRenderer.defaultSize()).scaled(pixelSize, pixelSize, Qt::KeepAspectRatio);
+        auto targetRect = QRectF(QPointF(0, 0), targetSize);
+        targetRect.moveCenter(QRectF(image.rect()).center());
+
+        QPainter painter(&image);
+        svgRenderer.render(&painter, targetRect);
+        painter.end();
+
+        image.setDevicePixelRatio(devicePixelRatio);
+        images.push_back(image);
+    }
+    return images;
+}
+
+
+QIcon
+IconCache::createIcon(const QVector<QImage>& images)
+{
+    QIcon icon;
+    for (const auto& image : images) {
+        icon.addPixmap(QPixmap::fromImage(image));
+    }
+    return icon;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+#include <QObject>
+#include <QPair>
+#include <QVector>
+
+// Rasterizes the svg icons once per device pixel ratio and keeps the results, so a theme
+// switch only swaps already created pixmaps. Both theme variants can be rasterized
+// on a worker thread at startup.
+class IconCache : public QObject {
+    Q_OBJECT
+
+public:
+    [[nodiscard]] static IconCache&
+    instance();
+
+    // Rasterize the icons in the background, the pixmaps are created once this is finished
+    void
+    preload(const QStringList& fileNames,
+            qreal              devicePixelRatio);
+
+    void
+    waitForPreload();
+
+    // Icon for the application's device pixel ratio, rasterized now if it has not been preloaded yet
+    [[nodiscard]] QIcon
+    getIcon(const QString& fileName);
+
+    void
+    clear();
+
+    [[nodiscard]] int
+    getCachedCount() const
+    {
+        return m_icons.count();
+    }
+
+    // All svg icons stored in the resources
+    [[nodiscard]] static QStringList
+    getResourceIconFileNames();
+
+private:
+    using IconKey = QPair<QString, qreal>;
+    using RasterizedIcons = QHash<IconKey, QVector<QImage> >;
+
+    IconCache();
+
+    void
+    insertPreloadedIcons();
+
+    [[nodiscard]] static QVector<QImage>
+    rasterize(const QString& fileName,
+              qreal          devicePixelRatio);
+
+    [[nodiscard]] static QIcon
+    createIcon(const QVector<QImage>& images);
+
+private:
+    QHash<IconKey, QIcon> m_icons;
+
+    QFutureWatcher<RasterizedIcons> m_preloadWatcher;
+
+    // Sizes used by the menus and tool tips. The window icon stays scalable
+    static constexpr int ICON_SIZES[] = { 16, 24, 32, 48, 64 };
+};
@@ -0,0 +1,55 @@
+#include "StringWidthCache.hpp"
+
+#include <QApplication>
+
+StringWidthCache&
+StringWidthCache::instance()
+{
+    static StringWidthCache stringWidthCache;
+    return stringWidthCache;
+}
+
+
+StringWidthCache::StringWidthCache() :
+    m_widths(MAX_CACHED_WIDTHS)
+{
+}
+
+
+int
+StringWidthCache::getWidth(const QString& str)
+{
+    if (const auto* const width = m_widths.object(str); width) {
+        return *width;
+    }
+
+    if (!m_fontMetrics) {
+        // Use a bold font for longer columns
+        auto font = QApplication::font();
+        font.setBold(true);
+        m_fontMetrics = std::make_unique<QFontMetrics>(font);
+    }
+
+    const auto width = m_fontMetrics->boundingRect(str).width();
+    m_widths.insert(str, new int(width));
+    return width;
+}
+
+
+int
+StringWidthCache::getMaximumWidth(const QStringList& strings)
+{
+    auto maximumWidth = 0;
+    for (const auto& str : strings) {
+        maximumWidth = std::max(maximumWidth, getWidth(str));
+    }
+    return maximumWidth;
+}
+
+
+void
+StringWidthCache::invalidate()
+{
+    m_widths.clear();
+    m_fontMetrics.reset();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QCache>
+#include <QFontMetrics>
+#include <QStringList>
+
+#include <memory>
+
+// Measures string widths in the bold application font. The font metrics are created once
+// and the widths of recently measured strings are kept in a least recently used cache.
+// Both have to be reset if the application font changes.
+class StringWidthCache {
+public:
+    [[nodiscard]] static StringWidthCache&
+    instance();
+
+    [[nodiscard]] int
+    getWidth(const QString& str);
+
+    // Width of the longest string
+    [[nodiscard]] int
+    getMaximumWidth(const QStringList& strings);
+
+    void
+    invalidate();
+
+    [[nodiscard]] int
+    getCachedCount() const
+    {
+        return m_widths.count();
+    }
+
+private:
+    StringWidthCache();
+
+private:
+    QCache<QString, int> m_widths;
+
+    // Created on first use, so the current application font is taken
+    std::unique_ptr<QFontMetrics> m_fontMetrics;
+
+    static constexpr int MAX_CACHED_WIDTHS = 2048;
+};
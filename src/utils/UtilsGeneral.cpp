@@ -1,6 +1,7 @@
 #include "UtilsGeneral.hpp"
 
 #include "AdditionalInfoWidget.hpp"
+#include "StringWidthCache.hpp"
 
 #include <QApplication>
 #include <QFileInfo>
@@ -34,12 +35,7 @@ rollDice()
 int
 getStringWidth(const QString& str)
 {
-    // Use a bold font for longer columns
-    auto font = QApplication::font();
-    font.setBold(true);
-
-    const QFontMetrics fontMetrics(font);
-    return fontMetrics.boundingRect(str).width();
+    return StringWidthCache::instance().getWidth(str);
 }
 
 
@@ -105,8 +101,8 @@ animateLabel(QPointer<QLabel> label)
 bool
 isSystemInDarkMode()
 {
-    const QWidget widget;
-    const auto color = widget.palette().color(QPalette::Window);
+    // Read the application palette directly instead of creating a widget for it
+    const auto color = QApplication::palette().color(QPalette::Window);
     const auto luminance = sqrt(0.299 * std::pow(color.redF(), 2) +
                                 0.587 * std::pow(color.greenF(), 2) +
                                 0.114 * std::pow(color.blueF(), 2));
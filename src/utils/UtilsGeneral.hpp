@@ -18,7 +18,7 @@ displayWarningMessageBox(QWidget*       widget,
 [[nodiscard]] int
 rollDice();
 
-// Get a QString width in pixels
+// Get a QString width in pixels, measured in the bold application font
 [[nodiscard]] int
 getStringWidth(const QString& str);
 
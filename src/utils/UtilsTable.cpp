@@ -7,26 +7,39 @@
 
 #include <QHBoxLayout>
 #include <QObject>
+#include <QPersistentModelIndex>
 #include <QWidget>
 
 namespace Utils::Table
 {
 void
-setTableAdditionalInfoWidget(CombatWidget* combatWidget, unsigned int row, const QVariant& additionalInfo)
+setTableAdditionalInfoWidget(CombatWidget* combatWidget, unsigned int row, const AdditionalInfoData& additionalInfo)
 {
     auto *const combatTableWidget = combatWidget->getCombatTableWidget();
 
     auto* const additionalInfoWidget = new AdditionalInfoWidget;
+    additionalInfoWidget->setMainInfoText(additionalInfo.mainInfoText);
+    additionalInfoWidget->setStatusEffects(additionalInfo.statusEffects);
+
+    // Connect after setting the data, the column widths for new widgets are adjusted in bulk by the caller
     QObject::connect(additionalInfoWidget, &AdditionalInfoWidget::widgetCalled, combatWidget, [combatWidget] {
+        combatWidget->startAction("Edit Additional Info");
         combatWidget->saveOldState();
     });
-    QObject::connect(additionalInfoWidget, &AdditionalInfoWidget::additionalInfoEdited, combatWidget, [combatWidget] {
+    // The persistent index follows the row if rows are inserted or removed in front of it
+    const QPersistentModelIndex index(combatTableWidget->model()->index(row, COL_ADDITIONAL));
+    QObject::connect(additionalInfoWidget, &AdditionalInfoWidget::additionalInfoEdited, combatWidget,
+                     [combatWidget, combatTableWidget, index] {
+        combatTableWidget->invalidateRowFingerprint(index.row());
         combatWidget->pushOnUndoStack(true);
     });
     QObject::connect(additionalInfoWidget, &AdditionalInfoWidget::widthAdjusted, combatWidget,
-                     [combatWidget, combatTableWidget, row] (int additionalInfoWidth) {
-        const auto nameWidth = Utils::General::getStringWidth(combatTableWidget->item(row, 0)->text());
-        combatWidget->resetNameAndInfoWidth(nameWidth, additionalInfoWidth);
+                     [combatWidget, combatTableWidget, index] (int additionalInfoWidth) {
+        const auto* const nameItem = index.isValid() ? combatTableWidget->item(index.row(), COL_NAME) : nullptr;
+        if (!nameItem) {
+            return;
+        }
+        combatWidget->resetNameAndInfoWidth(Utils::General::getStringWidth(nameItem->text()), additionalInfoWidth);
     });
 
     auto *const widget = new QWidget;
@@ -35,9 +48,7 @@ setTableAdditionalInfoWidget(CombatWidget* combatWidget, unsigned int row, const
     layout->setAlignment(Qt::AlignLeft);
     widget->setLayout(layout);
 
-    const auto converted = additionalInfo.value<AdditionalInfoData>();
-    additionalInfoWidget->setMainInfoText(converted.mainInfoText);
-    additionalInfoWidget->setStatusEffects(converted.statusEffects);
     combatTableWidget->setCellWidget(row, COL_ADDITIONAL, widget);
+    combatTableWidget->invalidateRowFingerprint(row);
 }
 }
@@ -1,16 +1,15 @@
 #pragma once
 
-#include <QVariant>
-
 class CombatWidget;
+struct AdditionalInfoData;
 
 // Utility functions for the Combat Table
 namespace Utils::Table
 {
 void
-setTableAdditionalInfoWidget(CombatWidget*   combatWidget,
-                             unsigned int    row,
-                             const QVariant& additionalInfo);
+setTableAdditionalInfoWidget(CombatWidget*             combatWidget,
+                             unsigned int              row,
+                             const AdditionalInfoData& additionalInfo);
 
 static constexpr int COL_NAME = 0;
 static constexpr int COL_INI = 1;
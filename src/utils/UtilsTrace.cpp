@@ -0,0 +1,118 @@
+#include "UtilsTrace.hpp"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils::Trace
+{
+namespace
+{
+struct Event {
+    const char* name;
+    qint64      start;
+    qint64      duration;
+    quint64     threadId;
+};
+
+// Keep the memory bounded if tracing is left enabled for a long session
+constexpr std::size_t MAX_EVENTS = 1000000;
+
+std::mutex eventMutex;
+std::vector<Event> events;
+QString traceFileName;
+
+const auto startTime = std::chrono::steady_clock::now();
+}
+
+namespace Internal
+{
+qint64
+getTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+
+void
+recordEvent(const char* name, qint64 start, qint64 duration)
+{
+    const auto threadId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+    const std::lock_guard<std::mutex> lock(eventMutex);
+    if (events.size() < MAX_EVENTS) {
+        events.push_back({ name, start, duration, threadId });
+    }
+}
+}
+
+
+void
+initialize()
+{
+    if (const auto fileName = qEnvironmentVariable("LCM_TRACE"); !fileName.isEmpty()) {
+        setEnabled(true, fileName);
+    }
+}
+
+
+void
+setEnabled(bool enabled, const QString& fileName)
+{
+    {
+        const std::lock_guard<std::mutex> lock(eventMutex);
+        traceFileName = fileName.isEmpty() ? "lcm_trace.json" : fileName;
+    }
+    Internal::isTracingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+
+bool
+writeTraceFile()
+{
+    std::vector<Event> eventsToWrite;
+    QString fileName;
+    {
+        const std::lock_guard<std::mutex> lock(eventMutex);
+        eventsToWrite = events;
+        fileName = traceFileName;
+    }
+    if (fileName.isEmpty()) {
+        return false;
+    }
+
+    const auto processId = (qint64) QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    for (const auto& event : eventsToWrite) {
+        // Complete events, containing begin and duration in microseconds
+        QJsonObject eventObject;
+        eventObject["name"] = event.name;
+        eventObject["cat"] = "lcm";
+        eventObject["ph"] = "X";
+        eventObject["ts"] = event.start;
+        eventObject["dur"] = event.duration;
+        eventObject["pid"] = processId;
+        // Only used to group the events, so a shorter value is fine
+        eventObject["tid"] = (qint64) (event.threadId % 1000000);
+        traceEvents.append(eventObject);
+    }
+
+    QJsonObject traceObject;
+    traceObject["traceEvents"] = traceEvents;
+    traceObject["displayTimeUnit"] = "ms";
+
+    QSaveFile traceFile(fileName);
+    if (!traceFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    traceFile.write(QJsonDocument(traceObject).toJson(QJsonDocument::Compact));
+    return traceFile.commit();
+}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+
+// Scoped tracing of hot paths. If tracing is enabled, each TRACE_SCOPE records the time spent in its scope.
+// The events are written in the Chrome trace_event format, which can be opened in chrome://tracing or Perfetto.
+// If disabled, a scope costs a single atomic load.
+namespace Utils::Trace
+{
+namespace Internal
+{
+inline std::atomic_bool isTracingEnabled{ false };
+
+[[nodiscard]] qint64
+getTimestamp();
+
+void
+recordEvent(const char* name,
+            qint64      start,
+            qint64      duration);
+}
+
+// Enable tracing if the LCM_TRACE environment variable is set. Its value is used as trace file name
+void
+initialize();
+
+void
+setEnabled(bool           enabled,
+           const QString& fileName = QString());
+
+[[nodiscard]] inline bool
+isEnabled()
+{
+    return Internal::isTracingEnabled.load(std::memory_order_relaxed);
+}
+
+// Write all events recorded so far into the trace file
+bool
+writeTraceFile();
+
+class Scope {
+public:
+    // The name has to be a string literal, it is stored without copying
+    explicit
+    Scope(const char* name) :
+        m_name(isEnabled() ? name : nullptr)
+    {
+        if (m_name) {
+            m_start = Internal::getTimestamp();
+        }
+    }
+
+    ~Scope()
+    {
+        if (m_name) {
+            Internal::recordEvent(m_name, m_start, Internal::getTimestamp() - m_start);
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope&
+    operator=(const Scope&) = delete;
+
+private:
+    const char* const m_name;
+    qint64 m_start{ 0 };
+};
+}
+
+#define TRACE_SCOPE_CONCAT_INNER(a, b) a ## b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) const Utils::Trace::Scope TRACE_SCOPE_CONCAT(traceScope, __LINE__)(name)
@@ -47,13 +47,14 @@ TEST_CASE("CharacterHandler Testing", "[CharacterHandler]") {
             charHandler->storeCharacter("Cleric", 7, 1, 31, false, {});
             charHandler->storeCharacter("Ranger", 27, 8, 36, false, {});
 
-            charHandler->sortCharacters(ruleSettings.ruleset, ruleSettings.rollAutomatical);
+            const auto sourceRows = charHandler->sortCharacters(ruleSettings.ruleset, ruleSettings.rollAutomatical);
             REQUIRE(charHandler->getCharacters().at(0).name == "Ranger");
             REQUIRE(charHandler->getCharacters().at(1).name == "Undead Boss");
             REQUIRE(charHandler->getCharacters().at(2).name == "Fighter");
             REQUIRE(charHandler->getCharacters().at(3).name == "Bard");
             REQUIRE(charHandler->getCharacters().at(4).name == "Zombie");
             REQUIRE(charHandler->getCharacters().at(5).name == "Cleric");
+            REQUIRE(sourceRows == QVector<int>{ 5, 3, 2, 0, 1, 4 });
         }
         SECTION("Sorting test - PF2") {
             ruleSettings.ruleset = RuleSettings::Ruleset::PATHFINDER_2E;
@@ -103,4 +104,100 @@ TEST_CASE("CharacterHandler Testing", "[CharacterHandler]") {
             REQUIRE(charHandler->getCharacters().size() == 0);
         }
     }
+
+    SECTION("Group tests") {
+        CharacterHandler::Character group("Goblin", 14, 2, 0, true, AdditionalInfoData{ {}, "Shortbow" });
+        REQUIRE(group.isGroup() == false);
+        REQUIRE(group.getInstanceCount() == 1);
+
+        group.setInstanceHp({ 7, 7, 5 });
+
+        SECTION("Hp is the sum of all instances") {
+            REQUIRE(group.isGroup() == true);
+            REQUIRE(group.getInstanceCount() == 3);
+            REQUIRE(group.hp == 19);
+        }
+        SECTION("Changed hp is applied to every instance") {
+            group.changeHp(-6);
+            REQUIRE(group.instanceHp == QVector<int>{ 1, 1, -1 });
+            REQUIRE(group.hp == 1);
+
+            group.changeHp(-20000);
+            REQUIRE(group.instanceHp == QVector<int>{ -10000, -10000, -10000 });
+        }
+        SECTION("Single instances are changed independently") {
+            group.changeHp(-4, 1);
+            REQUIRE(group.instanceHp == QVector<int>{ 7, 3, 5 });
+            REQUIRE(group.hp == 15);
+
+            // Out of range instances are ignored
+            group.changeHp(-4, 3);
+            REQUIRE(group.instanceHp == QVector<int>{ 7, 3, 5 });
+        }
+        SECTION("Instances are compared and fingerprinted") {
+            auto otherGroup = group;
+            REQUIRE(otherGroup == group);
+            REQUIRE(otherGroup.getFingerprint() == group.getFingerprint());
+
+            otherGroup.setInstanceHp({ 7, 5, 7 });
+            REQUIRE(otherGroup.hp == group.hp);
+            REQUIRE(otherGroup != group);
+            REQUIRE(otherGroup.getFingerprint() != group.getFingerprint());
+        }
+        SECTION("Expanded into single characters") {
+            const auto instances = group.getInstances(true);
+            REQUIRE(instances.size() == 3);
+            REQUIRE(instances.at(0).name == "Goblin #1");
+            REQUIRE(instances.at(2).name == "Goblin #3");
+            REQUIRE(instances.at(2).hp == 5);
+            REQUIRE(instances.at(2).isGroup() == false);
+            REQUIRE(instances.at(2).initiative == 14);
+            REQUIRE(instances.at(2).additionalInfoData.mainInfoText == "Shortbow");
+
+            REQUIRE(group.getInstances(false).at(1).name == "Goblin");
+        }
+    }
+
+    SECTION("Hp changes test") {
+        auto const charHandler = std::make_shared<CharacterHandler>();
+        charHandler->storeCharacter("Fighter", 19, 4, 36, false, {});
+        charHandler->storeCharacter("Rogue", 17, 5, 25, false, {});
+        charHandler->storeCharacter("Troll", 12, 1, 60, true, {});
+        charHandler->storeCharacter("Golem", 8, 0, 80, true, {});
+        charHandler->storeCharacter("Goblin", 14, 2, 0, true, {});
+        charHandler->getCharacters()[4].setInstanceHp({ 7, 5 });
+
+        SECTION("Rules") {
+            REQUIRE(CharacterHandler::getRuledHpValue(-15, CharacterHandler::HpRule::FULL) == -15);
+            REQUIRE(CharacterHandler::getRuledHpValue(-15, CharacterHandler::HpRule::HALF) == -7);
+            REQUIRE(CharacterHandler::getRuledHpValue(15, CharacterHandler::HpRule::HALF) == 7);
+            REQUIRE(CharacterHandler::getRuledHpValue(-15, CharacterHandler::HpRule::DOUBLE) == -30);
+            REQUIRE(CharacterHandler::getRuledHpValue(-15, CharacterHandler::HpRule::NONE) == 0);
+        }
+        SECTION("Different changes applied at once") {
+            const auto changedRows = charHandler->applyHpChanges({ { 4, -6, CharacterHandler::HpRule::FULL },
+                                                                   { 0, -15, CharacterHandler::HpRule::FULL },
+                                                                   { 1, -15, CharacterHandler::HpRule::HALF },
+                                                                   { 2, -15, CharacterHandler::HpRule::DOUBLE },
+                                                                   { 3, -15, CharacterHandler::HpRule::NONE },
+                                                                   { 4, -3, CharacterHandler::HpRule::FULL, 1 } });
+            REQUIRE(changedRows == std::vector<int>{ 0, 1, 2, 4 });
+
+            const auto& characters = charHandler->getCharacters();
+            REQUIRE(characters.at(0).hp == 21);
+            REQUIRE(characters.at(1).hp == 18);
+            REQUIRE(characters.at(2).hp == 30);
+            REQUIRE(characters.at(3).hp == 80);
+            REQUIRE(characters.at(4).instanceHp == QVector<int>{ 1, -4 });
+        }
+        SECTION("Values are clamped") {
+            const auto changedRows = charHandler->applyHpChanges({ { 3, 10000, CharacterHandler::HpRule::DOUBLE },
+                                                                   { 7, -5, CharacterHandler::HpRule::FULL } });
+            REQUIRE(changedRows == std::vector<int>{ 3 });
+            REQUIRE(charHandler->getCharacters().at(3).hp == 10000);
+
+            // Already at the maximum
+            REQUIRE(charHandler->applyHpChanges({ { 3, 5, CharacterHandler::HpRule::FULL } }).empty());
+        }
+    }
 }
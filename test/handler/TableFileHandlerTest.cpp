@@ -13,6 +13,7 @@
 
 #include <QFile>
 #include <QHBoxLayout>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QWidget>
 
@@ -98,6 +99,13 @@ TEST_CASE_METHOD(FileHandlerTestUtils, "TableFileHandler Testing", "[TableFileHa
             REQUIRE(tableSaved == true);
         }
 
+        SECTION("Failed save keeps the existing file") {
+            const auto tableSavedToInvalidDir = tableFileHandler->writeToFile(tableData, "dir/to/nonexisting/file.lcm", 0, 1,
+                                                                              ruleSettings.ruleset, ruleSettings.rollAutomatical);
+            REQUIRE(tableSavedToInvalidDir == false);
+            REQUIRE(tableFileHandler->getStatus("./test.lcm") == 0);
+        }
+
         SECTION("File format and content correct") {
             const auto codeCSVStatus = tableFileHandler->getStatus("./test.lcm");
             REQUIRE(codeCSVStatus == 0);
@@ -142,10 +150,69 @@ TEST_CASE_METHOD(FileHandlerTestUtils, "TableFileHandler Testing", "[TableFileHa
             REQUIRE(statusEffectsObject.empty() == true);
         }
 
+        SECTION("Group instances are stored") {
+            auto group = tableData.at(1);
+            REQUIRE(TableFileHandler::createCharacterObject(group).contains("instance_hp") == false);
+
+            group.setInstanceHp({ 42, 30 });
+            const auto groupObject = TableFileHandler::createCharacterObject(group);
+            REQUIRE(groupObject.value("hp").toInt() == 72);
+            REQUIRE(groupObject.value("instance_hp").toArray().size() == 2);
+            REQUIRE(groupObject.value("instance_hp").toArray().at(1).toInt() == 30);
+        }
+
+        SECTION("Header only loading") {
+            SECTION("Combat stats are read without the characters") {
+                const auto tableHeader = TableFileHandler::readTableHeader("./test.lcm");
+                REQUIRE(tableHeader.status == 0);
+                REQUIRE(tableHeader.rowEntered == 0);
+                REQUIRE(tableHeader.roundCounter == 1);
+                REQUIRE(tableHeader.ruleset == RuleSettings::Ruleset::PATHFINDER_2E);
+                REQUIRE(tableHeader.rollAutomatically == true);
+                REQUIRE(tableHeader.characterCount == 2);
+
+                // The combat stats are stored in front of the characters
+                QFile fileIn("./test.lcm");
+                fileIn.open(QIODevice::ReadOnly);
+                const auto byteArray = fileIn.readAll();
+                REQUIRE(byteArray.indexOf("\"round_counter\"") < byteArray.indexOf("\"characters\""));
+            }
+            SECTION("Table stored by an older version") {
+                // Sorted keys, so the characters are in front
+                QJsonObject charactersObject;
+                charactersObject["0"] = TableFileHandler::createCharacterObject(tableData.at(0));
+                QJsonObject jsonObject;
+                jsonObject["row_entered"] = 0;
+                jsonObject["round_counter"] = 4;
+                jsonObject["ruleset"] = 2;
+                jsonObject["roll_automatically"] = false;
+                jsonObject["characters"] = charactersObject;
+
+                QFile fileOut("./old.lcm");
+                fileOut.open(QIODevice::WriteOnly);
+                fileOut.write(QJsonDocument(jsonObject).toJson());
+                fileOut.close();
+
+                const auto tableHeader = TableFileHandler::readTableHeader("./old.lcm");
+                REQUIRE(tableHeader.status == 0);
+                REQUIRE(tableHeader.roundCounter == 4);
+                REQUIRE(tableHeader.ruleset == RuleSettings::Ruleset::DND_5E);
+                REQUIRE(tableHeader.characterCount == 1);
+            }
+            SECTION("Non readable/existing table") {
+                REQUIRE(TableFileHandler::readTableHeader("dir/to/nonexisting/file.lcm").status == 2);
+            }
+        }
+
         SECTION("Check format test") {
             SECTION("Functioning table") {
                 REQUIRE(tableFileHandler->getStatus(resolvePath("./test.lcm")) == 0);
             }
+            SECTION("Functioning table, buffered reading") {
+                tableFileHandler->setMemoryMappingEnabled(false);
+                REQUIRE(tableFileHandler->getStatus(resolvePath("./test.lcm")) == 0);
+                REQUIRE(tableFileHandler->getData().value("characters").toObject().size() == 2);
+            }
             SECTION("Broken table") {
                 // Incomplete json object
                 QJsonObject jsonObject;
@@ -167,5 +234,6 @@ TEST_CASE_METHOD(FileHandlerTestUtils, "TableFileHandler Testing", "[TableFileHa
 
         std::remove("./test.lcm");
         std::remove("./broken.lcm");
+        std::remove("./old.lcm");
     }
 }
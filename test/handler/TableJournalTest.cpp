@@ -0,0 +1,152 @@
+#include "AdditionalInfoData.hpp"
+#include "CharacterHandler.hpp"
+#include "RuleSettings.hpp"
+#include "TableJournal.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QDir>
+#include <QFile>
+#include <QJsonObject>
+
+TEST_CASE("TableJournal Testing", "[TableJournal]") {
+    const auto directory = QDir::currentPath() + "/autosave_test";
+    auto tableJournal = std::make_unique<TableJournal>(directory);
+
+    const auto createRow = [] (const QString& name, int initiative, int hp, const QString& mainInfo) {
+        return CharacterHandler::Character(name, initiative, 2, hp, false, AdditionalInfoData{ {}, mainInfo });
+    };
+    const auto createOperation = [] (TableJournal::Operation::Type type, int row, const CharacterHandler::Character& character = {}) {
+        TableJournal::Operation operation;
+        operation.type = type;
+        operation.row = row;
+        operation.character = character;
+        return operation;
+    };
+
+    QVector<CharacterHandler::Character> tableData{ createRow("Fighter", 19, 36, "Haste"), createRow("Boss", 21, 42, "") };
+    tableJournal->start(tableData, 0, 1, RuleSettings::Ruleset::PATHFINDER_2E, true);
+    tableJournal->waitForWrites();
+
+    SECTION("Checkpoint written") {
+        REQUIRE(tableJournal->hasRecoverableData());
+
+        QJsonObject tableObject;
+        REQUIRE(tableJournal->recover(tableObject));
+        REQUIRE(tableObject.value("ruleset").toInt() == 1);
+        REQUIRE(tableObject.value("roll_automatically").toBool() == true);
+        REQUIRE(tableObject.value("characters").toObject().size() == 2);
+    }
+    SECTION("Changes are recovered from the journal") {
+        tableData[1].hp = 12;
+        tableJournal->append({ createOperation(TableJournal::Operation::Type::SET, 1, tableData[1]) }, 1, 1);
+        tableJournal->append({ createOperation(TableJournal::Operation::Type::REMOVE, 0) }, 0, 2);
+        tableJournal->waitForWrites();
+
+        QJsonObject tableObject;
+        REQUIRE(tableJournal->recover(tableObject));
+        REQUIRE(tableObject.value("row_entered").toInt() == 0);
+        REQUIRE(tableObject.value("round_counter").toInt() == 2);
+
+        const auto charactersObject = tableObject.value("characters").toObject();
+        REQUIRE(charactersObject.size() == 1);
+        REQUIRE(charactersObject.value("0").toObject().value("name").toString() == "Boss");
+        REQUIRE(charactersObject.value("0").toObject().value("hp").toInt() == 12);
+    }
+    SECTION("Records older than the checkpoint are skipped") {
+        const auto journalFileName = directory + "/autosave.journal";
+        tableData[1].hp = 12;
+        tableJournal->append({ createOperation(TableJournal::Operation::Type::SET, 1, tableData[1]) }, 1, 1);
+        tableJournal->waitForWrites();
+
+        QFile journalFile(journalFileName);
+        journalFile.open(QIODevice::ReadOnly);
+        const auto staleRecords = journalFile.readAll();
+        journalFile.close();
+
+        // Simulate a crash after a newer checkpoint has been stored, but before the journal was removed
+        tableData[1].hp = 20;
+        tableJournal->start(tableData, 0, 3, RuleSettings::Ruleset::PATHFINDER_2E, true);
+        tableJournal->waitForWrites();
+        journalFile.open(QIODevice::WriteOnly);
+        journalFile.write(staleRecords);
+        journalFile.close();
+
+        QJsonObject tableObject;
+        REQUIRE(tableJournal->recover(tableObject));
+        REQUIRE(tableObject.value("row_entered").toInt() == 0);
+        REQUIRE(tableObject.value("round_counter").toInt() == 3);
+        REQUIRE(tableObject.value("characters").toObject().value("1").toObject().value("hp").toInt() == 20);
+    }
+    SECTION("Only operations are appended") {
+        const auto journalFileName = directory + "/autosave.journal";
+        tableData[0].hp = 30;
+        tableJournal->append({ createOperation(TableJournal::Operation::Type::SET, 0, tableData[0]) }, 0, 1);
+        tableJournal->waitForWrites();
+        const auto sizeAfterFirstRecord = QFile(journalFileName).size();
+
+        // Nothing changed, so nothing is written
+        tableJournal->append({}, 0, 1);
+        tableJournal->waitForWrites();
+        REQUIRE(QFile(journalFileName).size() == sizeAfterFirstRecord);
+
+        // Inserting in front does not rewrite the following rows
+        tableJournal->append({ createOperation(TableJournal::Operation::Type::INSERT, 0, createRow("Rogue", 15, 24, "")) }, 0, 1);
+        tableJournal->waitForWrites();
+        const auto sizeAfterInsertion = QFile(journalFileName).size();
+        REQUIRE(sizeAfterInsertion - sizeAfterFirstRecord < 2 * sizeAfterFirstRecord);
+
+        QJsonObject tableObject;
+        REQUIRE(tableJournal->recover(tableObject));
+        const auto charactersObject = tableObject.value("characters").toObject();
+        REQUIRE(tableObject.value("character_count").toInt() == 3);
+        REQUIRE(charactersObject.value("0").toObject().value("name").toString() == "Rogue");
+        REQUIRE(charactersObject.value("1").toObject().value("hp").toInt() == 30);
+        REQUIRE(charactersObject.value("2").toObject().value("name").toString() == "Boss");
+    }
+    SECTION("Moved and reordered rows") {
+        tableJournal->append({ createOperation(TableJournal::Operation::Type::INSERT, 2, createRow("Rogue", 15, 24, "")) }, 0, 1);
+        // Fighter, Boss, Rogue -> Boss, Rogue, Fighter
+        tableJournal->append({ TableJournal::createOrderOperation({ 1, 2, 0 }) }, 0, 1);
+        // -> Fighter, Rogue, Boss
+        tableJournal->append({ TableJournal::createOrderOperation({ 2, 1, 0 }) }, 0, 1);
+        tableJournal->waitForWrites();
+
+        QJsonObject tableObject;
+        REQUIRE(tableJournal->recover(tableObject));
+        const auto charactersObject = tableObject.value("characters").toObject();
+        REQUIRE(charactersObject.value("0").toObject().value("name").toString() == "Fighter");
+        REQUIRE(charactersObject.value("1").toObject().value("name").toString() == "Rogue");
+        REQUIRE(charactersObject.value("2").toObject().value("name").toString() == "Boss");
+    }
+    SECTION("Single moves are detected") {
+        const auto movedDown = TableJournal::createOrderOperation({ 1, 2, 0, 3 });
+        REQUIRE(movedDown.type == TableJournal::Operation::Type::MOVE);
+        REQUIRE(movedDown.row == 0);
+        REQUIRE(movedDown.targetRow == 2);
+
+        const auto movedUp = TableJournal::createOrderOperation({ 0, 3, 1, 2 });
+        REQUIRE(movedUp.type == TableJournal::Operation::Type::MOVE);
+        REQUIRE(movedUp.row == 3);
+        REQUIRE(movedUp.targetRow == 1);
+
+        const auto swapped = TableJournal::createOrderOperation({ 0, 2, 1 });
+        REQUIRE(swapped.type == TableJournal::Operation::Type::MOVE);
+        REQUIRE(swapped.row == 1);
+        REQUIRE(swapped.targetRow == 2);
+
+        REQUIRE(TableJournal::createOrderOperation({ 2, 1, 0 }).type == TableJournal::Operation::Type::ORDER);
+    }
+    SECTION("Clearing removes the autosave") {
+        tableJournal->clear();
+        tableJournal->waitForWrites();
+        REQUIRE(!tableJournal->hasRecoverableData());
+    }
+
+    tableJournal.reset();
+    QDir(directory).removeRecursively();
+}
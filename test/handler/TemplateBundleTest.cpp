@@ -0,0 +1,161 @@
+#include "CharacterHandler.hpp"
+#include "CharFileHandler.hpp"
+#include "TemplateBundle.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+TEST_CASE("TemplateBundle Testing", "[TemplateBundle]") {
+    const auto bundleFileName = QDir::currentPath() + "/test.bundle";
+    QFile::remove(bundleFileName);
+
+    auto templateBundle = std::make_unique<TemplateBundle>(bundleFileName);
+    REQUIRE(templateBundle->open());
+    REQUIRE(templateBundle->append(CharacterHandler::Character("Goblin", 0, 1, 6, true, AdditionalInfoData{ {}, "" })));
+    REQUIRE(templateBundle->append(CharacterHandler::Character("Ogre", 0, -1, 30, true, AdditionalInfoData{ {}, "Large" })));
+
+    SECTION("Lookup by name") {
+        CharacterHandler::Character character;
+        REQUIRE(templateBundle->read("Ogre", character));
+        REQUIRE(character.name == "Ogre");
+        REQUIRE(character.modifier == -1);
+        REQUIRE(character.hp == 30);
+        REQUIRE(character.isEnemy == true);
+        REQUIRE(character.additionalInfoData.mainInfoText == "Large");
+
+        REQUIRE(!templateBundle->read("Wolf", character));
+    }
+    SECTION("Replaced and removed templates after reopening") {
+        REQUIRE(templateBundle->append(CharacterHandler::Character("Goblin", 0, 1, 60, true, AdditionalInfoData{ {}, "Chief" })));
+        REQUIRE(templateBundle->remove("Ogre"));
+        REQUIRE(!templateBundle->remove("Ogre"));
+
+        templateBundle = std::make_unique<TemplateBundle>(bundleFileName);
+        REQUIRE(templateBundle->open());
+        REQUIRE(templateBundle->getNames() == QStringList{ "Goblin" });
+
+        CharacterHandler::Character character;
+        REQUIRE(templateBundle->read("Goblin", character));
+        REQUIRE(character.hp == 60);
+        REQUIRE(character.additionalInfoData.mainInfoText == "Chief");
+    }
+    SECTION("Interrupted append is discarded") {
+        templateBundle.reset();
+        QFile bundleFile(bundleFileName);
+        bundleFile.open(QIODevice::Append);
+        // Size field promising more data than available
+        bundleFile.write(QByteArray::fromHex("000000ff0001"));
+        bundleFile.close();
+
+        templateBundle = std::make_unique<TemplateBundle>(bundleFileName);
+        REQUIRE(templateBundle->open());
+        REQUIRE(templateBundle->contains("Goblin"));
+        REQUIRE(templateBundle->contains("Ogre"));
+        REQUIRE(templateBundle->append(CharacterHandler::Character("Wolf", 0, 2, 13, true, AdditionalInfoData{ {}, "" })));
+
+        templateBundle = std::make_unique<TemplateBundle>(bundleFileName);
+        REQUIRE(templateBundle->open());
+        REQUIRE(templateBundle->contains("Wolf"));
+    }
+    SECTION("Compaction drops outdated records") {
+        for (auto i = 0; i < 10; i++) {
+            REQUIRE(templateBundle->append(CharacterHandler::Character("Goblin", 0, 1, i, true, AdditionalInfoData{ {}, "" })));
+        }
+        const auto sizeBefore = QFileInfo(bundleFileName).size();
+        REQUIRE(templateBundle->compact());
+        REQUIRE(QFileInfo(bundleFileName).size() < sizeBefore);
+
+        CharacterHandler::Character character;
+        REQUIRE(templateBundle->read("Goblin", character));
+        REQUIRE(character.hp == 9);
+        REQUIRE(templateBundle->read("Ogre", character));
+    }
+    SECTION("Export and import loose templates") {
+        const auto directory = QDir::currentPath() + "/bundle_test/";
+        REQUIRE(templateBundle->exportDirectory(directory) == 2);
+
+        CharacterHandler::Character character;
+        REQUIRE(CharFileHandler::readCharacter(directory + "Ogre.char", character) == 0);
+        REQUIRE(character.hp == 30);
+
+        QFile::remove(bundleFileName);
+        templateBundle = std::make_unique<TemplateBundle>(bundleFileName);
+        REQUIRE(templateBundle->open());
+        REQUIRE(templateBundle->importDirectory(directory) == 2);
+        REQUIRE(templateBundle->read("Goblin", character));
+        REQUIRE(character.modifier == 1);
+
+        QDir(directory).removeRecursively();
+    }
+    SECTION("Read-only bundles are not modified") {
+        templateBundle.reset();
+        QFile bundleFile(bundleFileName);
+        bundleFile.open(QIODevice::Append);
+        bundleFile.write(QByteArray::fromHex("000000ff0001"));
+        bundleFile.close();
+        const auto bundleSize = QFileInfo(bundleFileName).size();
+
+        templateBundle = std::make_unique<TemplateBundle>(bundleFileName);
+        REQUIRE(templateBundle->open(true));
+        REQUIRE(templateBundle->contains("Ogre"));
+        REQUIRE(!templateBundle->append(CharacterHandler::Character("Wolf", 0, 2, 13, true, AdditionalInfoData{ {}, "" })));
+        REQUIRE(QFileInfo(bundleFileName).size() == bundleSize);
+
+        const auto emptyFileName = QDir::currentPath() + "/empty.bundle";
+        QFile emptyFile(emptyFileName);
+        REQUIRE(emptyFile.open(QIODevice::WriteOnly));
+        emptyFile.close();
+
+        TemplateBundle emptyBundle(emptyFileName);
+        REQUIRE(!emptyBundle.open(true));
+        REQUIRE(QFileInfo(emptyFileName).size() == 0);
+
+        QFile::remove(emptyFileName);
+    }
+    SECTION("Names leading outside of the directory are not exported") {
+        REQUIRE(templateBundle->append(CharacterHandler::Character("../escaped", 0, 0, 1, true, AdditionalInfoData{ {}, "" })));
+
+        const auto directory = QDir::currentPath() + "/bundle_test/";
+        REQUIRE(templateBundle->exportDirectory(directory) == 2);
+        REQUIRE(!QFile::exists(QDir::currentPath() + "/escaped.char"));
+
+        QDir(directory).removeRecursively();
+    }
+    SECTION("Write a complete bundle") {
+        const auto writtenFileName = QDir::currentPath() + "/written.bundle";
+        REQUIRE(TemplateBundle::writeBundle(writtenFileName, { CharacterHandler::Character("Wolf", 0, 2, 13, true, AdditionalInfoData{ {}, "" }) }));
+
+        TemplateBundle writtenBundle(writtenFileName);
+        REQUIRE(writtenBundle.open(true));
+        REQUIRE(writtenBundle.getNames() == QStringList{ "Wolf" });
+
+        CharacterHandler::Character character;
+        REQUIRE(writtenBundle.read("Wolf", character));
+        REQUIRE(character.hp == 13);
+
+        QFile::remove(writtenFileName);
+    }
+    SECTION("Other files are left untouched") {
+        const auto otherFileName = QDir::currentPath() + "/other.txt";
+        QFile otherFile(otherFileName);
+        REQUIRE(otherFile.open(QIODevice::WriteOnly));
+        otherFile.write("abc");
+        otherFile.close();
+
+        TemplateBundle otherBundle(otherFileName);
+        REQUIRE(!otherBundle.open());
+        REQUIRE(QFileInfo(otherFileName).size() == 3);
+
+        QFile::remove(otherFileName);
+    }
+
+    templateBundle.reset();
+    QFile::remove(bundleFileName);
+}
@@ -0,0 +1,95 @@
+#include "CharacterHandler.hpp"
+#include "CharFileHandler.hpp"
+#include "TemplateIndex.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+
+TEST_CASE("TemplateIndex Testing", "[TemplateIndex]") {
+    const auto directory = QDir::currentPath() + "/index_test/";
+    QDir().mkpath(directory);
+
+    const auto writeTemplate = [&directory] (const CharacterHandler::Character& character) {
+        QFile fileOut(directory + character.name + ".char");
+        fileOut.open(QIODevice::WriteOnly);
+        fileOut.write(QJsonDocument(CharFileHandler::createCharacterObject(character)).toJson());
+    };
+    writeTemplate(CharacterHandler::Character("Goblin", 0, 1, 6, true, AdditionalInfoData{ {}, "" }));
+    writeTemplate(CharacterHandler::Character("Ogre", 0, -1, 30, true, AdditionalInfoData{ {}, "Large" }));
+
+    TemplateIndex templateIndex(directory);
+    templateIndex.load();
+
+    SECTION("All templates indexed") {
+        REQUIRE(QFile::exists(QDir::currentPath() + "/index_test.index"));
+
+        const auto& entries = templateIndex.getEntries();
+        REQUIRE(entries.size() == 2);
+        REQUIRE(entries.contains("Goblin.char"));
+        REQUIRE(entries.value("Ogre.char").character.hp == 30);
+        REQUIRE(entries.value("Ogre.char").character.additionalInfoData.mainInfoText == "Large");
+    }
+    SECTION("Stored index is read again") {
+        TemplateIndex storedTemplateIndex(directory);
+        storedTemplateIndex.load();
+
+        const auto& entries = storedTemplateIndex.getEntries();
+        REQUIRE(entries.size() == 2);
+        REQUIRE(entries.value("Goblin.char").character.modifier == 1);
+        REQUIRE(entries.value("Goblin.char").character.isEnemy == true);
+    }
+    SECTION("Added, changed and removed templates are detected") {
+        writeTemplate(CharacterHandler::Character("Wolf", 0, 2, 13, true, AdditionalInfoData{ {}, "" }));
+        writeTemplate(CharacterHandler::Character("Goblin", 0, 1, 600, true, AdditionalInfoData{ {}, "Chief" }));
+        QFile::remove(directory + "Ogre.char");
+
+        TemplateIndex storedTemplateIndex(directory);
+        storedTemplateIndex.load();
+
+        const auto& entries = storedTemplateIndex.getEntries();
+        REQUIRE(entries.size() == 2);
+        REQUIRE(entries.value("Wolf.char").character.hp == 13);
+        REQUIRE(entries.value("Goblin.char").character.hp == 600);
+        REQUIRE(!entries.contains("Ogre.char"));
+    }
+    SECTION("Changed templates are parsed separately") {
+        writeTemplate(CharacterHandler::Character("Wolf", 0, 2, 13, true, AdditionalInfoData{ {}, "" }));
+
+        TemplateIndex storedTemplateIndex(directory);
+        const auto changedFiles = storedTemplateIndex.validate();
+        REQUIRE(changedFiles == QStringList{ directory + "Wolf.char" });
+        REQUIRE(storedTemplateIndex.getEntries().size() == 2);
+
+        const auto parseResult = TemplateIndex::parseTemplate(changedFiles.first());
+        REQUIRE(parseResult.isValid);
+        REQUIRE(parseResult.fileName == "Wolf.char");
+        REQUIRE(parseResult.entry.character.hp == 13);
+
+        storedTemplateIndex.insert(parseResult);
+        REQUIRE(storedTemplateIndex.getEntries().size() == 3);
+        REQUIRE(storedTemplateIndex.isModified());
+    }
+    SECTION("Own changes are stored") {
+        const auto character = CharacterHandler::Character("Wolf", 0, 2, 13, true, AdditionalInfoData{ {}, "" });
+        writeTemplate(character);
+        templateIndex.insert("Wolf.char", character);
+        templateIndex.remove("Goblin.char");
+        REQUIRE(templateIndex.write());
+
+        TemplateIndex storedTemplateIndex(directory);
+        storedTemplateIndex.load();
+        REQUIRE(storedTemplateIndex.getEntries().contains("Wolf.char"));
+        // The file still exists, so it is indexed again
+        REQUIRE(storedTemplateIndex.getEntries().contains("Goblin.char"));
+    }
+
+    QDir(directory).removeRecursively();
+    QFile::remove(QDir::currentPath() + "/index_test.index");
+}
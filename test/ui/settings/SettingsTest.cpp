@@ -1,6 +1,7 @@
 #include "AdditionalSettings.hpp"
 #include "DirSettings.hpp"
 #include "RuleSettings.hpp"
+#include "SettingsStore.hpp"
 #include "TableSettings.hpp"
 
 #ifdef CATCH2_V3
@@ -12,10 +13,12 @@
 #include <QSettings>
 
 TEST_CASE("Settings Testing", "[Settings]") {
+    auto& settingsStore = SettingsStore::instance();
+
     SECTION("Additional settings test") {
         AdditionalSettings additionalSettings;
         QSettings settings;
-        settings.clear();
+        settingsStore.clear();
 
         settings.beginGroup("AdditionalSettings");
         REQUIRE(settings.value("indicatorMultipleChars").isValid() == false);
@@ -24,6 +27,7 @@ TEST_CASE("Settings Testing", "[Settings]") {
         settings.endGroup();
 
         additionalSettings.write(false, true, false);
+        settingsStore.flush();
         settings.beginGroup("AdditionalSettings");
         REQUIRE(settings.value("indicatorMultipleChars").isValid() == true);
         REQUIRE(settings.value("rollIniMultipleChars").isValid() == true);
@@ -34,6 +38,7 @@ TEST_CASE("Settings Testing", "[Settings]") {
         settings.endGroup();
 
         additionalSettings.write(true, false, true);
+        settingsStore.flush();
         settings.beginGroup("AdditionalSettings");
         REQUIRE(settings.value("indicatorMultipleChars").toBool() == true);
         REQUIRE(settings.value("rollIniMultipleChars").toBool() == false);
@@ -44,25 +49,38 @@ TEST_CASE("Settings Testing", "[Settings]") {
     SECTION("Dir settings test") {
         DirSettings dirSettings;
         QSettings settings;
-        settings.clear();
+        settingsStore.clear();
 
         REQUIRE(settings.value("dir_save").isValid() == false);
         REQUIRE(settings.value("dir_open").isValid() == false);
 
         dirSettings.write("/example/path/dir_open_and_save", true);
+        settingsStore.flush();
         REQUIRE(settings.value("dir_save").isValid() == true);
         REQUIRE(settings.value("dir_open").isValid() == true);
         REQUIRE(settings.value("dir_open").toString() == "/example/path/dir_open_and_save");
         REQUIRE(settings.value("dir_save").toString() == "/example/path/dir_open_and_save");
 
         dirSettings.write("/example/path/new_path", false);
+        settingsStore.flush();
         REQUIRE(settings.value("dir_open").toString() == "/example/path/new_path");
         REQUIRE(settings.value("dir_save").toString() == "/example/path/dir_open_and_save");
+
+        REQUIRE(settings.value("recent_files").isValid() == false);
+        dirSettings.addRecentFile("/example/path/first.lcm");
+        dirSettings.addRecentFile("/example/path/second.lcm");
+        settingsStore.flush();
+        REQUIRE(settings.value("recent_files").toStringList() == QStringList{ "/example/path/second.lcm", "/example/path/first.lcm" });
+
+        // Reopened files move to the front without being duplicated
+        dirSettings.addRecentFile("/example/path/first.lcm");
+        settingsStore.flush();
+        REQUIRE(settings.value("recent_files").toStringList() == QStringList{ "/example/path/first.lcm", "/example/path/second.lcm" });
     }
     SECTION("Rule settings test") {
         RuleSettings ruleSettings;
         QSettings settings;
-        settings.clear();
+        settingsStore.clear();
 
         settings.beginGroup("RuleSettings");
         REQUIRE(settings.value("ruleset").isValid() == false);
@@ -70,6 +88,7 @@ TEST_CASE("Settings Testing", "[Settings]") {
         settings.endGroup();
 
         ruleSettings.write(2, true);
+        settingsStore.flush();
         settings.beginGroup("RuleSettings");
         REQUIRE(settings.value("ruleset").isValid() == true);
         REQUIRE(settings.value("roll_auto").isValid() == true);
@@ -81,7 +100,7 @@ TEST_CASE("Settings Testing", "[Settings]") {
     SECTION("Table settings test") {
         TableSettings tableSettings;
         QSettings settings;
-        settings.clear();
+        settingsStore.clear();
 
         settings.beginGroup("TableSettings");
         REQUIRE(settings.value("INI").isValid() == false);
@@ -94,6 +113,7 @@ TEST_CASE("Settings Testing", "[Settings]") {
         tableSettings.write(TableSettings::ValueType::MOD_SHOWN, true);
         tableSettings.write(TableSettings::ValueType::COLOR_TABLE, false);
         tableSettings.write(TableSettings::ValueType::SHOW_INI_TOOLTIPS, false);
+        settingsStore.flush();
 
         settings.beginGroup("TableSettings");
         REQUIRE(settings.value("INI").isValid() == true);
@@ -107,4 +127,37 @@ TEST_CASE("Settings Testing", "[Settings]") {
         REQUIRE(settings.value("IniToolTips").toBool() == false);
         settings.endGroup();
     }
+
+    SECTION("Settings store test") {
+        QSettings settings;
+        settingsStore.clear();
+
+        QStringList changedKeys;
+        QVariantList changedValues;
+        QObject context;
+        QObject::connect(&settingsStore, &SettingsStore::valueChanged, &context, [&] (const QString& key, const QVariant& value) {
+            changedKeys.push_back(key);
+            changedValues.push_back(value);
+        });
+
+        TableSettings tableSettings;
+        REQUIRE(tableSettings.iniShown == true);
+
+        tableSettings.write(TableSettings::ValueType::INI_SHOWN, false);
+        REQUIRE(changedKeys == QStringList{ TableSettings::getKey(TableSettings::ValueType::INI_SHOWN) });
+        REQUIRE(changedValues.at(0).toBool() == false);
+
+        // Unchanged values are neither signaled nor written again
+        tableSettings.write(TableSettings::ValueType::INI_SHOWN, false);
+        REQUIRE(changedKeys.size() == 1);
+
+        // Reads are served from memory before the change is written
+        REQUIRE(settingsStore.hasPendingChanges() == true);
+        REQUIRE(settings.value("TableSettings/INI").isValid() == false);
+        REQUIRE(TableSettings().iniShown == false);
+
+        settingsStore.flush();
+        REQUIRE(settingsStore.hasPendingChanges() == false);
+        REQUIRE(settings.value("TableSettings/INI").toBool() == false);
+    }
 }
@@ -80,6 +80,65 @@ TEST_CASE("Combat Table Testing", "[TableUtils]") {
         }
     }
 
+    SECTION("Group row test") {
+        auto group = combatTableWidget->tableDataFromWidget().at(1);
+        group.setInstanceHp({ 22, 22, 20 });
+        combatTableWidget->setHpItem(1, group);
+
+        REQUIRE(combatTableWidget->item(1, 3)->text() == "64");
+        REQUIRE(!(combatTableWidget->item(1, 3)->flags() & Qt::ItemIsEditable));
+        REQUIRE(combatTableWidget->getInstanceCount(0) == 1);
+        REQUIRE(combatTableWidget->getInstanceCount(1) == 3);
+
+        combatTableWidget->resynchronizeCharacters();
+        REQUIRE(characterHandler->getCharacters().at(1) == group);
+        REQUIRE(combatTableWidget->getRowFingerprint(1) == group.getFingerprint());
+
+        group.setInstanceHp({});
+        combatTableWidget->setHpItem(1, group);
+        REQUIRE(combatTableWidget->getInstanceCount(1) == 1);
+        REQUIRE(combatTableWidget->item(1, 3)->flags() & Qt::ItemIsEditable);
+    }
+
+    SECTION("Row fingerprints test") {
+        const auto rowFingerprints = combatTableWidget->getRowFingerprints();
+        const auto tableFingerprint = combatTableWidget->getTableFingerprint();
+        const auto tableData = combatTableWidget->tableDataFromWidget();
+
+        SECTION("Fingerprints match the row content") {
+            REQUIRE(rowFingerprints.size() == 2);
+            REQUIRE(rowFingerprints.at(0) == tableData.at(0).getFingerprint());
+            REQUIRE(rowFingerprints.at(1) == tableData.at(1).getFingerprint());
+            REQUIRE(rowFingerprints.at(0) != rowFingerprints.at(1));
+        }
+        SECTION("Changed cells change the fingerprints") {
+            combatTableWidget->item(1, 3)->setText("60");
+            REQUIRE(combatTableWidget->getRowFingerprint(0) == rowFingerprints.at(0));
+            REQUIRE(combatTableWidget->getRowFingerprint(1) != rowFingerprints.at(1));
+            REQUIRE(combatTableWidget->getTableFingerprint() != tableFingerprint);
+
+            // Reverting the change restores the fingerprints
+            combatTableWidget->item(1, 3)->setText("66");
+            REQUIRE(combatTableWidget->getRowFingerprint(1) == rowFingerprints.at(1));
+            REQUIRE(combatTableWidget->getTableFingerprint() == tableFingerprint);
+        }
+        SECTION("Changed cell widgets change the fingerprints") {
+            combatTableWidget->setStatusEffectInWidget({}, 0);
+            REQUIRE(combatTableWidget->getRowFingerprint(0) != rowFingerprints.at(0));
+            REQUIRE(combatTableWidget->getTableFingerprint() != tableFingerprint);
+        }
+        SECTION("Inserted and removed rows shift the fingerprints") {
+            combatTableWidget->insertRow(0);
+            combatTableWidget->removeRow(0);
+            REQUIRE(combatTableWidget->getRowFingerprints() == rowFingerprints);
+            REQUIRE(combatTableWidget->getTableFingerprint() == tableFingerprint);
+
+            combatTableWidget->removeRow(0);
+            REQUIRE(combatTableWidget->getRowFingerprints() == QVector<quint64>{ rowFingerprints.at(1) });
+            REQUIRE(combatTableWidget->getTableFingerprint() != tableFingerprint);
+        }
+    }
+
     SECTION("Set row and player test") {
         auto* const roundCounterLabel = new QLabel;
         auto* const currentPlayerLabel = new QLabel;
@@ -107,22 +166,27 @@ TEST_CASE("Combat Table Testing", "[TableUtils]") {
     }
 
     SECTION("Row coloring test") {
-        const auto color = QApplication::palette().color(QPalette::Base);
-
         SECTION("Set color") {
             combatTableWidget->setTableRowColor(false);
 
-            REQUIRE(combatTableWidget->item(0, 0)->background().color() == QColor(12, 123, 220, 60));
-            REQUIRE(combatTableWidget->cellWidget(0, 5)->palette().color(QPalette::Base) == QColor(12, 123, 220, 60));
-            REQUIRE(combatTableWidget->item(1, 0)->background().color() == QColor(255, 194, 10, 60));
+            REQUIRE(combatTableWidget->getRowColor(0) == QColor(12, 123, 220, 60));
+            REQUIRE(combatTableWidget->getRowColor(1) == QColor(255, 194, 10, 60));
+            // The cell widgets are transparent, so the color painted behind them is visible
+            REQUIRE(combatTableWidget->cellWidget(0, 5)->autoFillBackground() == false);
+        }
+        SECTION("Changed enemy state") {
+            combatTableWidget->setTableRowColor(false);
+            combatTableWidget->item(0, 4)->setCheckState(Qt::Checked);
+
+            REQUIRE(combatTableWidget->getRowColor(0) == QColor(255, 194, 10, 60));
         }
         SECTION("Reset color") {
+            combatTableWidget->setTableRowColor(false);
             combatTableWidget->setTableRowColor(true);
 
-            REQUIRE(combatTableWidget->item(0, 0)->background().color() == color);
-            REQUIRE(combatTableWidget->cellWidget(0, 5)->palette().color(QPalette::Base) == color);
-            REQUIRE(combatTableWidget->item(1, 0)->background().color() == color);
-            REQUIRE(combatTableWidget->cellWidget(1, 5)->palette().color(QPalette::Base) == color);
+            REQUIRE(combatTableWidget->getRowColor(0).isValid() == false);
+            REQUIRE(combatTableWidget->getRowColor(1).isValid() == false);
+            REQUIRE(combatTableWidget->cellWidget(1, 5)->autoFillBackground() == false);
         }
     }
 
@@ -130,14 +194,22 @@ TEST_CASE("Combat Table Testing", "[TableUtils]") {
         SECTION("Set tooltip") {
             combatTableWidget->setIniColumnTooltips(false);
 
-            REQUIRE(combatTableWidget->item(0, 1)->toolTip() == "Calculation: Rolled Value 17, Modifier 2");
-            REQUIRE(combatTableWidget->item(1, 1)->toolTip() == "Calculation: Rolled Value 18, Modifier 5");
+            REQUIRE(combatTableWidget->getIniToolTip(0) == "Calculation: Rolled Value 17, Modifier 2");
+            REQUIRE(combatTableWidget->getIniToolTip(1) == "Calculation: Rolled Value 18, Modifier 5");
+            // Nothing is stored in the items
+            REQUIRE(combatTableWidget->item(0, 1)->toolTip() == "");
+        }
+        SECTION("Tooltip uses the current values") {
+            combatTableWidget->setIniColumnTooltips(false);
+            combatTableWidget->item(0, 1)->setText("22");
+
+            REQUIRE(combatTableWidget->getIniToolTip(0) == "Calculation: Rolled Value 20, Modifier 2");
         }
         SECTION("Reset tooltip") {
             combatTableWidget->setIniColumnTooltips(true);
 
-            REQUIRE(combatTableWidget->item(0, 1)->toolTip() == "");
-            REQUIRE(combatTableWidget->item(1, 1)->toolTip() == "");
+            REQUIRE(combatTableWidget->getIniToolTip(0) == "");
+            REQUIRE(combatTableWidget->getIniToolTip(1) == "");
         }
     }
 
@@ -145,13 +217,13 @@ TEST_CASE("Combat Table Testing", "[TableUtils]") {
         auto tableData = combatTableWidget->tableDataFromWidget();
 
         SECTION("Check stats") {
-            const auto converted = tableData.at(0).at(5).value<AdditionalInfoData>();
+            const auto& converted = tableData.at(0).additionalInfoData;
 
-            REQUIRE(tableData.at(0).at(0) == "Fighter");
-            REQUIRE(tableData.at(0).at(1) == "19");
-            REQUIRE(tableData.at(0).at(2) == "2");
-            REQUIRE(tableData.at(0).at(3) == "36");
-            REQUIRE(tableData.at(0).at(4) == false);
+            REQUIRE(tableData.at(0).name == "Fighter");
+            REQUIRE(tableData.at(0).initiative == 19);
+            REQUIRE(tableData.at(0).modifier == 2);
+            REQUIRE(tableData.at(0).hp == 36);
+            REQUIRE(tableData.at(0).isEnemy == false);
             REQUIRE(converted.mainInfoText == "Haste");
             REQUIRE(converted.statusEffects.at(0).name == "Shaken");
             REQUIRE(converted.statusEffects.at(0).isPermanent == false);
@@ -162,8 +234,19 @@ TEST_CASE("Combat Table Testing", "[TableUtils]") {
             combatTableWidget->item(0, 4)->setCheckState(Qt::Checked);
             tableData = combatTableWidget->tableDataFromWidget();
 
-            REQUIRE(tableData.at(0).at(3) == "24");
-            REQUIRE(tableData.at(0).at(4) == true);
+            REQUIRE(tableData.at(0).hp == 24);
+            REQUIRE(tableData.at(0).isEnemy == true);
+        }
+        SECTION("Rows compare and hash by value") {
+            const auto otherTableData = combatTableWidget->tableDataFromWidget();
+            REQUIRE(otherTableData == tableData);
+            REQUIRE(qHash(otherTableData.at(0)) == qHash(tableData.at(0)));
+            REQUIRE(tableData.at(0) != tableData.at(1));
+
+            combatTableWidget->item(0, 1)->setText("20");
+            const auto changedRow = combatTableWidget->tableDataFromWidget().at(0);
+            REQUIRE(changedRow != tableData.at(0));
+            REQUIRE(qHash(changedRow) != qHash(tableData.at(0)));
         }
     }
 
@@ -173,13 +256,13 @@ TEST_CASE("Combat Table Testing", "[TableUtils]") {
         auto tableData = combatTableWidget->tableDataFromCharacterVector();
 
         SECTION("Check stats") {
-            const auto converted = tableData.at(0).at(5).value<AdditionalInfoData>();
+            const auto& converted = tableData.at(0).additionalInfoData;
 
-            REQUIRE(tableData.at(0).at(0) == "Fighter");
-            REQUIRE(tableData.at(0).at(1) == "19");
-            REQUIRE(tableData.at(0).at(2) == "2");
-            REQUIRE(tableData.at(0).at(3) == "36");
-            REQUIRE(tableData.at(0).at(4) == false);
+            REQUIRE(tableData.at(0).name == "Fighter");
+            REQUIRE(tableData.at(0).initiative == 19);
+            REQUIRE(tableData.at(0).modifier == 2);
+            REQUIRE(tableData.at(0).hp == 36);
+            REQUIRE(tableData.at(0).isEnemy == false);
             REQUIRE(converted.mainInfoText == "Haste");
             REQUIRE(converted.statusEffects.at(0).name == "Shaken");
             REQUIRE(converted.statusEffects.at(0).isPermanent == false);
@@ -192,8 +275,8 @@ TEST_CASE("Combat Table Testing", "[TableUtils]") {
             characters = characterHandler->getCharacters();
             tableData = combatTableWidget->tableDataFromCharacterVector();
 
-            REQUIRE(tableData.at(0).at(3) == "24");
-            REQUIRE(tableData.at(0).at(4) == true);
+            REQUIRE(tableData.at(0).hp == 24);
+            REQUIRE(tableData.at(0).isEnemy == true);
         }
     }
 
@@ -0,0 +1,55 @@
+#include "LatencyMonitor.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+TEST_CASE("Latency Monitor Testing", "[LatencyMonitor]") {
+    LatencyMonitor latencyMonitor;
+    latencyMonitor.setEnabled(true);
+
+    SECTION("Percentiles") {
+        QVector<qint64> samples;
+        for (auto i = 100; i > 0; i--) {
+            samples.push_back(i);
+        }
+        REQUIRE(LatencyMonitor::getPercentile(samples, 50) == 50);
+        REQUIRE(LatencyMonitor::getPercentile(samples, 95) == 95);
+        REQUIRE(LatencyMonitor::getPercentile(samples, 99) == 99);
+        REQUIRE(LatencyMonitor::getPercentile({ 7 }, 99) == 7);
+        REQUIRE(LatencyMonitor::getPercentile({}, 50) == 0);
+    }
+    SECTION("Statistics per action") {
+        for (auto i = 1; i <= 20; i++) {
+            latencyMonitor.addSample("Next", i * 1000);
+        }
+        latencyMonitor.addSample("Remove", 500);
+
+        const auto nextStatistics = latencyMonitor.getStatistics("Next");
+        REQUIRE(nextStatistics.count == 20);
+        REQUIRE(nextStatistics.p50 == 10000);
+        REQUIRE(nextStatistics.p95 == 19000);
+        REQUIRE(nextStatistics.p99 == 20000);
+        REQUIRE(latencyMonitor.getStatistics("Remove").count == 1);
+        REQUIRE(latencyMonitor.getStatistics("Undo").count == 0);
+
+        REQUIRE(latencyMonitor.getReport().contains("Next: n = 20, p50 = 10000, p95 = 19000, p99 = 20000"));
+    }
+    SECTION("Action until paint") {
+        latencyMonitor.start("Resort Table");
+        latencyMonitor.finish();
+        REQUIRE(latencyMonitor.getStatistics("Resort Table").count == 1);
+
+        // A paint without a started action is not counted
+        latencyMonitor.finish();
+        REQUIRE(latencyMonitor.getStatistics("Resort Table").count == 1);
+    }
+    SECTION("Disabled monitor") {
+        latencyMonitor.setEnabled(false);
+        latencyMonitor.start("Resort Table");
+        latencyMonitor.finish();
+        REQUIRE(latencyMonitor.getStatistics("Resort Table").count == 0);
+    }
+}
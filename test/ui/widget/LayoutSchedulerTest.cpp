@@ -0,0 +1,68 @@
+#include "LayoutScheduler.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QCoreApplication>
+
+TEST_CASE("Layout Scheduler Testing", "[LayoutScheduler]") {
+    LayoutScheduler layoutScheduler;
+
+    auto widthPasses = 0;
+    auto heightPasses = 0;
+    QObject::connect(&layoutScheduler, &LayoutScheduler::widthPassRequested, [&widthPasses] {
+        widthPasses++;
+    });
+    QObject::connect(&layoutScheduler, &LayoutScheduler::heightPassRequested, [&heightPasses] {
+        heightPasses++;
+    });
+
+    layoutScheduler.setAction("Load Table");
+    for (auto i = 0; i < 50; i++) {
+        layoutScheduler.markWidthDirty();
+        layoutScheduler.markHeightDirty();
+    }
+
+    SECTION("Passes are deferred") {
+        REQUIRE(layoutScheduler.isPending() == true);
+        REQUIRE(widthPasses == 0);
+        REQUIRE(heightPasses == 0);
+    }
+    SECTION("Requests are coalesced into a single pass") {
+        layoutScheduler.flush();
+        REQUIRE(layoutScheduler.isPending() == false);
+        REQUIRE(widthPasses == 1);
+        REQUIRE(heightPasses == 1);
+
+        // Nothing left to do
+        layoutScheduler.flush();
+        REQUIRE(widthPasses == 1);
+    }
+    SECTION("Passes run in the next event loop iteration") {
+        QCoreApplication::processEvents();
+        REQUIRE(layoutScheduler.isPending() == false);
+        REQUIRE(widthPasses == 1);
+        REQUIRE(heightPasses == 1);
+    }
+    SECTION("Passes are counted per action") {
+        layoutScheduler.flush();
+        layoutScheduler.setAction("Undo");
+        layoutScheduler.markHeightDirty();
+        layoutScheduler.flush();
+
+        const auto loadPassCount = layoutScheduler.getPassCount("Load Table");
+        REQUIRE(loadPassCount.widthRequests == 50);
+        REQUIRE(loadPassCount.heightRequests == 50);
+        REQUIRE(loadPassCount.widthPasses == 1);
+        REQUIRE(loadPassCount.heightPasses == 1);
+
+        const auto undoPassCount = layoutScheduler.getPassCount("Undo");
+        REQUIRE(undoPassCount.widthRequests == 0);
+        REQUIRE(undoPassCount.heightRequests == 1);
+        REQUIRE(undoPassCount.widthPasses == 0);
+        REQUIRE(undoPassCount.heightPasses == 1);
+    }
+}
@@ -0,0 +1,54 @@
+#include "AdditionalInfoWidget.hpp"
+#include "StatusEffectsWidget.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+TEST_CASE("Status Effects Widget Testing", "[StatusEffectsWidget]") {
+    auto *const statusEffectsWidget = new StatusEffectsWidget;
+
+    const QVector<AdditionalInfoData::StatusEffect> effects{
+        AdditionalInfoData::StatusEffect("Shaken", false, 2),
+        AdditionalInfoData::StatusEffect("Exhausted", true, 0)
+    };
+    statusEffectsWidget->setStatusEffects(effects);
+
+    SECTION("Chip texts") {
+        REQUIRE(StatusEffectsWidget::getChipText(effects.at(0)) == "Shaken (2)");
+        REQUIRE(StatusEffectsWidget::getChipText(effects.at(1)) == "Exhausted");
+    }
+    SECTION("Hit testing") {
+        const auto firstChipRect = statusEffectsWidget->getChipRect(0);
+        const auto secondChipRect = statusEffectsWidget->getChipRect(1);
+        REQUIRE(firstChipRect.right() < secondChipRect.left());
+
+        REQUIRE(statusEffectsWidget->getChipIndexAt(firstChipRect.center()) == 0);
+        REQUIRE(statusEffectsWidget->getChipIndexAt(secondChipRect.center()) == 1);
+        // Position of the label
+        REQUIRE(statusEffectsWidget->getChipIndexAt(QPoint(0, firstChipRect.center().y())) == -1);
+        REQUIRE(statusEffectsWidget->getWidth() >= secondChipRect.right());
+    }
+    SECTION("No effects") {
+        statusEffectsWidget->setStatusEffects({});
+        REQUIRE(statusEffectsWidget->getWidth() == 0);
+        REQUIRE(statusEffectsWidget->getChipIndexAt(QPoint(0, 0)) == -1);
+    }
+    SECTION("Setting effects again does not create additional widgets") {
+        auto *const additionalInfoWidget = new AdditionalInfoWidget;
+        additionalInfoWidget->setStatusEffects(effects);
+        const auto childCount = additionalInfoWidget->findChildren<QWidget *>().size();
+
+        for (auto i = 0; i < 10; i++) {
+            additionalInfoWidget->setStatusEffects(effects);
+        }
+        REQUIRE(additionalInfoWidget->findChildren<QWidget *>().size() == childCount);
+        REQUIRE(additionalInfoWidget->getAdditionalInformation().statusEffects.size() == 2);
+
+        delete additionalInfoWidget;
+    }
+
+    delete statusEffectsWidget;
+}
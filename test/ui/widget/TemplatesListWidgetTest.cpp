@@ -31,6 +31,38 @@ TEST_CASE("Templates List Widget Testing", "[TableUtils]") {
         const auto sameCharacterAddedAgain = templatesListWidget->addCharacter(character);
         REQUIRE(sameCharacterAddedAgain == false);
     }
+    SECTION("Add multiple characters") {
+        const QVector<CharacterHandler::Character> characters{
+            CharacterHandler::Character("Wolf", 0, 2, 13, true, AdditionalInfoData{ {}, "" }),
+            CharacterHandler::Character("Bear", 0, 2, 34, true, AdditionalInfoData{ {}, "" }),
+            character
+        };
+        templatesListWidget->addCharacters(characters);
+        // Already added characters are skipped, the others are sorted
+        REQUIRE(templatesListWidget->count() == 3);
+        REQUIRE(templatesListWidget->item(0)->text() == "Bear");
+        REQUIRE(templatesListWidget->item(1)->text() == "Wolf");
+        REQUIRE(templatesListWidget->item(2)->text() == "test");
+    }
+    SECTION("Update character") {
+        const auto changedCharacter = CharacterHandler::Character("test", 0, 1, 25, true, AdditionalInfoData{ {}, "" });
+        templatesListWidget->updateCharacter(changedCharacter);
+        REQUIRE(templatesListWidget->count() == 1);
+
+        const auto storedCharacter = templatesListWidget->item(0)->data(Qt::UserRole).value<CharacterHandler::Character>();
+        REQUIRE(storedCharacter.hp == 25);
+        REQUIRE(storedCharacter.isEnemy == true);
+
+        // Unknown characters are added
+        templatesListWidget->updateCharacter(CharacterHandler::Character("Wolf", 0, 2, 13, true, AdditionalInfoData{ {}, "" }));
+        REQUIRE(templatesListWidget->count() == 2);
+    }
+    SECTION("Remove character by name") {
+        REQUIRE(templatesListWidget->removeCharacter(QString("test")) == true);
+        REQUIRE(templatesListWidget->count() == 0);
+        // Removed characters can be added again
+        REQUIRE(templatesListWidget->addCharacter(character) == true);
+    }
     SECTION("Remove character test") {
         const auto characterRemoved = templatesListWidget->removeCharacter(character);
         REQUIRE(characterRemoved == true);
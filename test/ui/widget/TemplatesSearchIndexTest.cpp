@@ -0,0 +1,54 @@
+#include "CharacterHandler.hpp"
+#include "TemplatesSearchIndex.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+TEST_CASE("Templates Search Index Testing", "[TemplatesSearchIndex]") {
+    TemplatesSearchIndex searchIndex;
+    searchIndex.insert(CharacterHandler::Character("Goblin", 0, 1, 6, true, AdditionalInfoData{ {}, "" }));
+    searchIndex.insert(CharacterHandler::Character("Goblin Chief", 0, 2, 25, true, AdditionalInfoData{ {}, "" }));
+    searchIndex.insert(CharacterHandler::Character("Hobgoblin", 0, 1, 11, true, AdditionalInfoData{ {}, "" }));
+    searchIndex.insert(CharacterHandler::Character("Fighter", 0, 2, 36, false, AdditionalInfoData{ {}, "" }));
+    searchIndex.insert(CharacterHandler::Character("Wolf", 0, 2, 13, true, AdditionalInfoData{ {}, "" }));
+
+    const auto getNames = [] (const QVector<CharacterHandler::Character>& characters) {
+        QStringList names;
+        for (const auto& character : characters) {
+            names.push_back(character.name);
+        }
+        return names;
+    };
+
+    SECTION("Ranked matching") {
+        // Exact before prefix before substring
+        REQUIRE(getNames(searchIndex.search("goblin", 10)) == QStringList{ "Goblin", "Goblin Chief", "Hobgoblin" });
+        REQUIRE(getNames(searchIndex.search("chief", 10)) == QStringList{ "Goblin Chief" });
+        REQUIRE(getNames(searchIndex.search("goblin", 1)) == QStringList{ "Goblin" });
+    }
+    SECTION("Typos and abbreviations") {
+        REQUIRE(getNames(searchIndex.search("gobiln", 10)).first() == "Goblin");
+        REQUIRE(getNames(searchIndex.search("figther", 10)) == QStringList{ "Fighter" });
+        REQUIRE(getNames(searchIndex.search("fgt", 10)) == QStringList{ "Fighter" });
+        REQUIRE(searchIndex.search("dragon", 10).isEmpty());
+    }
+    SECTION("Filters") {
+        REQUIRE(getNames(searchIndex.search("goblin hp>10", 10)) == QStringList{ "Goblin Chief", "Hobgoblin" });
+        REQUIRE(getNames(searchIndex.search("mod=2 is:enemy", 10)) == QStringList{ "Goblin Chief", "Wolf" });
+        REQUIRE(getNames(searchIndex.search("is:ally", 10)) == QStringList{ "Fighter" });
+        REQUIRE(getNames(searchIndex.search("hp<=6", 10)) == QStringList{ "Goblin" });
+    }
+    SECTION("Replace and remove") {
+        searchIndex.insert(CharacterHandler::Character("Wolf", 0, 2, 40, true, AdditionalInfoData{ {}, "" }));
+        REQUIRE(searchIndex.size() == 5);
+        REQUIRE(searchIndex.search("wolf", 10).first().hp == 40);
+
+        searchIndex.remove("Goblin");
+        REQUIRE(searchIndex.size() == 4);
+        REQUIRE(getNames(searchIndex.search("goblin", 10)) == QStringList{ "Goblin Chief", "Hobgoblin" });
+        REQUIRE(searchIndex.search("wolf", 10).size() == 1);
+    }
+}
@@ -0,0 +1,67 @@
+#include "IconCache.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QApplication>
+#include <QFile>
+
+#include <cstdio>
+
+TEST_CASE("Icon Cache Testing", "[IconCache]") {
+    const auto writeSvgFile = [] (const QString& fileName, const QString& color) {
+        QFile file(fileName);
+        file.open(QIODevice::WriteOnly);
+        file.write(QString("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"24\" height=\"24\">"
+                           "<rect width=\"24\" height=\"24\" fill=\"%1\"/></svg>").arg(color).toUtf8());
+    };
+    writeSvgFile("./icon_black.svg", "black");
+    writeSvgFile("./icon_white.svg", "white");
+
+    auto& iconCache = IconCache::instance();
+    iconCache.clear();
+
+    SECTION("Preloaded icons") {
+        iconCache.preload({ "./icon_black.svg", "./icon_white.svg" }, qApp->devicePixelRatio());
+        iconCache.waitForPreload();
+        REQUIRE(iconCache.getCachedCount() == 2);
+
+        const auto icon = iconCache.getIcon("./icon_white.svg");
+        REQUIRE(!icon.isNull());
+        REQUIRE(!icon.availableSizes().empty());
+        REQUIRE(iconCache.getCachedCount() == 2);
+
+        const auto image = icon.pixmap(16, 16).toImage();
+        REQUIRE(image.pixelColor(image.width() / 2, image.height() / 2) == QColor(Qt::white));
+    }
+    SECTION("Icons which have not been preloaded") {
+        const auto icon = iconCache.getIcon("./icon_black.svg");
+        REQUIRE(!icon.isNull());
+        REQUIRE(iconCache.getCachedCount() == 1);
+
+        // The same icon is returned for a theme switch back
+        static_cast<void>(iconCache.getIcon("./icon_black.svg"));
+        REQUIRE(iconCache.getCachedCount() == 1);
+    }
+    SECTION("Missed icons do not wait for the preload") {
+        iconCache.preload({ "./icon_black.svg", "./icon_white.svg" }, qApp->devicePixelRatio());
+        REQUIRE(!iconCache.getIcon("./icon_black.svg").isNull());
+
+        // The preloaded results do not replace the already created icon
+        iconCache.waitForPreload();
+        REQUIRE(iconCache.getCachedCount() == 2);
+    }
+    SECTION("Other device pixel ratios are cached separately") {
+        iconCache.preload({ "./icon_black.svg" }, qApp->devicePixelRatio() * 2);
+        iconCache.waitForPreload();
+        static_cast<void>(iconCache.getIcon("./icon_black.svg"));
+        REQUIRE(iconCache.getCachedCount() == 2);
+    }
+
+    iconCache.clear();
+    std::remove("./icon_black.svg");
+    std::remove("./icon_white.svg");
+}
@@ -0,0 +1,50 @@
+#include "StringWidthCache.hpp"
+#include "UtilsGeneral.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QApplication>
+
+TEST_CASE("String Width Cache Testing", "[StringWidthCache]") {
+    auto& stringWidthCache = StringWidthCache::instance();
+    stringWidthCache.invalidate();
+
+    auto font = QApplication::font();
+    font.setBold(true);
+    const QFontMetrics fontMetrics(font);
+
+    SECTION("Width is measured in the bold font") {
+        REQUIRE(stringWidthCache.getWidth("Fighter") == fontMetrics.boundingRect("Fighter").width());
+        REQUIRE(Utils::General::getStringWidth("Fighter") == fontMetrics.boundingRect("Fighter").width());
+    }
+    SECTION("Measured widths are cached") {
+        REQUIRE(stringWidthCache.getCachedCount() == 0);
+        static_cast<void>(stringWidthCache.getWidth("Fighter"));
+        static_cast<void>(stringWidthCache.getWidth("Fighter"));
+        static_cast<void>(stringWidthCache.getWidth("Boss"));
+        REQUIRE(stringWidthCache.getCachedCount() == 2);
+    }
+    SECTION("Maximum width") {
+        const QStringList names{ "Rat", "Ancient Red Dragon", "Boss" };
+        REQUIRE(stringWidthCache.getMaximumWidth(names) == stringWidthCache.getWidth("Ancient Red Dragon"));
+        REQUIRE(stringWidthCache.getMaximumWidth({}) == 0);
+    }
+    SECTION("Invalidation takes the new application font") {
+        const auto oldFont = QApplication::font();
+        static_cast<void>(stringWidthCache.getWidth("Fighter"));
+
+        auto largerFont = oldFont;
+        largerFont.setPointSize(std::max(oldFont.pointSize(), 12) * 2);
+        QApplication::setFont(largerFont);
+        stringWidthCache.invalidate();
+
+        REQUIRE(stringWidthCache.getCachedCount() == 0);
+        REQUIRE(stringWidthCache.getWidth("Fighter") > fontMetrics.boundingRect("Fighter").width());
+
+        QApplication::setFont(oldFont);
+    }
+}
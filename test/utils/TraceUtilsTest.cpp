@@ -0,0 +1,65 @@
+#include "UtilsTrace.hpp"
+
+#ifdef CATCH2_V3
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cstdio>
+
+TEST_CASE("Trace Util Testing", "[TraceUtils]") {
+    SECTION("Disabled tracing records nothing") {
+        Utils::Trace::setEnabled(false, "./trace_disabled.json");
+        {
+            TRACE_SCOPE("Disabled scope");
+        }
+        REQUIRE(Utils::Trace::writeTraceFile() == true);
+
+        QFile traceFile("./trace_disabled.json");
+        REQUIRE(traceFile.open(QIODevice::ReadOnly));
+        const auto traceEvents = QJsonDocument::fromJson(traceFile.readAll()).object().value("traceEvents").toArray();
+        for (const auto& traceEvent : traceEvents) {
+            REQUIRE(traceEvent.toObject().value("name").toString() != "Disabled scope");
+        }
+    }
+    SECTION("Enabled tracing writes complete events") {
+        Utils::Trace::setEnabled(true, "./trace_enabled.json");
+        {
+            TRACE_SCOPE("Outer scope");
+            TRACE_SCOPE("Inner scope");
+        }
+        Utils::Trace::setEnabled(false, "./trace_enabled.json");
+        REQUIRE(Utils::Trace::writeTraceFile() == true);
+
+        QFile traceFile("./trace_enabled.json");
+        REQUIRE(traceFile.open(QIODevice::ReadOnly));
+        const auto traceObject = QJsonDocument::fromJson(traceFile.readAll()).object();
+        const auto traceEvents = traceObject.value("traceEvents").toArray();
+
+        QJsonObject outerEvent;
+        QJsonObject innerEvent;
+        for (const auto& traceEvent : traceEvents) {
+            const auto eventObject = traceEvent.toObject();
+            if (eventObject.value("name").toString() == "Outer scope") {
+                outerEvent = eventObject;
+            } else if (eventObject.value("name").toString() == "Inner scope") {
+                innerEvent = eventObject;
+            }
+        }
+        REQUIRE(outerEvent.value("ph").toString() == "X");
+        REQUIRE(innerEvent.value("ph").toString() == "X");
+        // The inner scope is nested in the outer one
+        REQUIRE(innerEvent.value("ts").toDouble() >= outerEvent.value("ts").toDouble());
+        REQUIRE(innerEvent.value("dur").toDouble() <= outerEvent.value("dur").toDouble());
+        REQUIRE(innerEvent.value("tid") == outerEvent.value("tid"));
+    }
+
+    std::remove("./trace_disabled.json");
+    std::remove("./trace_enabled.json");
+}